@@ -7,20 +7,25 @@
 #include <stdexcept>
 #include <vector>
 #include <utility> // Para std::pair
+#include "../estatisticas_arvore.hpp"
+#include "../politica_estatisticas.hpp"
+#include "../prefixo_chave.hpp"
 
 template <typename KeyType, typename ValueType, typename Compare = std::less<KeyType>>
 struct AVLNode {
     KeyType key;
     ValueType value; // Agora armazena o valor separadamente
+    PrefixoChave prefixo; // 8 primeiros bytes e tamanho da chave (decide a maioria das comparações)
     int height;
     AVLNode* left;
     AVLNode* right;
 
-    AVLNode(const KeyType& k, const ValueType& v)
-        : key(k), value(v), height(1), left(nullptr), right(nullptr) {}
+    AVLNode(const KeyType& k, const ValueType& v, const PrefixoChave& p = PrefixoChave())
+        : key(k), value(v), prefixo(p), height(1), left(nullptr), right(nullptr) {}
 };
 
-template <typename KeyType, typename ValueType, typename Compare = std::less<KeyType>>
+// 'Stats' escolhe a instrumentação: CountingStats (comparações e rotações) ou NullStats (nenhuma).
+template <typename KeyType, typename ValueType, typename Compare = std::less<KeyType>, typename Stats = CountingStats>
 class Set { // Renomeado para 'Set' mas funciona como um 'Map' AVL
 public:
     Set() = default;
@@ -28,21 +33,34 @@ public:
 
     // Insere um par chave-valor na árvore AVL. Se a chave já existe, atualiza seu valor.
     void Insert(const KeyType& key, const ValueType& value) {
-        root = _insert(root, key, value);
+        bool inserido;
+        AVLNode<KeyType, ValueType>* node = _insert(key, value, inserido);
+        if (!inserido) node->value = value;
+    }
+
+    // Endereço do valor da chave, inserida com ValueType{} se ainda não existir (uma só descida).
+    // Continua válido até a próxima remoção (Erase pode copiar outra chave para o nó): Versao() muda.
+    ValueType* FindOrInsert(const KeyType& key) {
+        bool inserido;
+        return &_insert(key, ValueType{}, inserido)->value;
     }
 
     // Remove um elemento da árvore AVL pela chave.
     void Erase(const KeyType& key) {
-        root = _erase(root, key);
+        _erase(key);
     }
 
+    // Muda a cada remoção de nó e a cada Clear: endereços obtidos com FindOrInsert antes
+    // disso podem não valer mais.
+    size_t Versao() const { return m_versao; }
+
     // Verifica se uma chave está presente no conjunto.
     bool Contains(const KeyType& key) const {
         // Resetamos as comparações para que 'Contains' conte apenas as suas.
         // Se você quiser o total acumulado, não resete aqui.
         // Para testes de desempenho isolados, resetar é útil.
         // m_comparisons = 0; // Remova este reset se quiser acumular
-        return _contains(root, key);
+        return _contains(root, key, Comparador::prefixo(key));
     }
 
     // Limpa todos os elementos do conjunto.
@@ -50,8 +68,9 @@ public:
         destroy(root);
         root = nullptr;
         size = 0;
-        m_comparisons = 0;
-        m_rotations = 0;
+        ++m_versao;
+        m_stats.resetComparacoes();
+        m_stats.resetReestruturacoes();
     }
 
     // Retorna o menor elemento do conjunto (o par chave-valor).
@@ -94,12 +113,13 @@ public:
 
     // Retorna o valor (frequência) associado a uma chave específica. Retorna ValueType{} se a chave não for encontrada.
     ValueType getCount(const KeyType& key) const {
+        const PrefixoChave p = Comparador::prefixo(key);
         AVLNode<KeyType, ValueType>* curr = root;
         while (curr != nullptr) {
-            m_comparisons++; // Comparação para decidir o caminho
-            if (compare(key, curr->key)) { // key < curr->key
+            int c = comparar(key, p, curr);
+            if (c < 0) { // key < curr->key
                 curr = curr->left;
-            } else if (compare(curr->key, key)) { // key > curr->key
+            } else if (c > 0) { // key > curr->key
                 curr = curr->right;
             } else { // key == curr->key
                 return curr->value;
@@ -125,18 +145,42 @@ public:
         return result;
     }
 
-    // Métodos para acessar as métricas
-    long long getComparacoesPrincipais() const { return m_comparisons; }
-    long long getRotacoes() const { return m_rotations; }
-    void resetComparacoes() { m_comparisons = 0; }
-    void resetRotacoes() { m_rotations = 0; }
+    // Calcula a forma da árvore (altura, nós por nível, caminhos de busca).
+    // 'peso(chave, valor)' dá a frequência de acesso de cada nó; sem ele, todos pesam 1.
+    template <typename Peso>
+    EstatisticasArvore EstatisticasForma(Peso peso) const {
+        EstatisticasArvore estatisticas;
+        shape_collect(root, 1, peso, estatisticas);
+        return estatisticas;
+    }
+
+    EstatisticasArvore EstatisticasForma() const {
+        return EstatisticasForma([](const KeyType&, const ValueType&) { return 1.0; });
+    }
+
+    // Métodos para acessar as métricas.
+    // Comparações = desempates que precisaram das chaves completas (prefixos de 8 bytes iguais).
+    long long getComparacoesPrincipais() const { return m_stats.comparacoes(); }
+    long long getRotacoes() const { return m_stats.reestruturacoes(); }
+    void resetComparacoes() { m_stats.resetComparacoes(); }
+    void resetRotacoes() { m_stats.resetReestruturacoes(); }
 
 private:
     AVLNode<KeyType, ValueType>* root{nullptr};
     int size{0};
-    mutable long long m_comparisons = 0; // 'mutable' para permitir incremento em métodos const
-    long long m_rotations = 0;
-    Compare compare; // Objeto comparador para chaves
+    size_t m_versao{0}; // remoções de nós e Clears (ver Versao())
+    Stats m_stats; // Contadores de comparações e rotações (vazio com NullStats)
+    using Comparador = ComparadorPrefixo<KeyType, Compare>;
+    Comparador m_comparador; // Comparação em três vias pelo prefixo, com desempate pela chave
+
+    // < 0, 0 ou > 0 conforme 'key' (de prefixo 'p') vem antes, é igual ou vem depois da chave do nó.
+    // Só o caminho lento (prefixos empatados) lê as chaves e conta como comparação.
+    int comparar(const KeyType& key, const PrefixoChave& p, const AVLNode<KeyType, ValueType>* node) const {
+        int resultado;
+        if (Comparador::decide(p, node->prefixo, resultado)) return resultado;
+        m_stats.comparacao();
+        return m_comparador.comparar(key, node->key);
+    }
 
     // Retorna a altura de um nó
     int height(AVLNode<KeyType, ValueType>* node) const {
@@ -169,106 +213,106 @@ private:
         return y;
     }
 
-    // Função auxiliar recursiva para inserir um elemento na árvore AVL e rebalancear.
-    AVLNode<KeyType, ValueType>* _insert(AVLNode<KeyType, ValueType>* node, const KeyType& key, const ValueType& value) {
-        if (!node) {
-            size++;
-            return new AVLNode<KeyType, ValueType>(key, value);
-        }
-
-        m_comparisons++; // Comparação para decidir o caminho
-        if (compare(key, node->key)) { // key < node->key
-            node->left = _insert(node->left, key, value);
-        } else if (compare(node->key, key)) { // key > node->key
-            node->right = _insert(node->right, key, value);
-        } else { // key == node->key (chave já existe, atualiza o valor)
-            node->value = value;
-            return node;
+    // Maior altura possível de uma AVL com até 2^31 nós (1.44 * log2 n < 46), com folga.
+    static constexpr int ALTURA_MAXIMA = 64;
+    using Link = AVLNode<KeyType, ValueType>**; // Endereço do ponteiro que aponta para um nó
+
+    // Rebalanceia o nó apontado por 'link' se o fator de balanceamento saiu de [-1, 1].
+    // O filho mais alto com fator oposto pede rotação dupla (casos LR e RL).
+    void rebalancear(Link link) {
+        AVLNode<KeyType, ValueType>* node = *link;
+        int bal = balance(node);
+        if (bal > 1) {
+            if (balance(node->left) < 0) { // Rotação dupla à esquerda-direita
+                m_stats.reestruturacao(2);
+                node->left = left_rotation(node->left);
+            } else { // Rotação simples à direita
+                m_stats.reestruturacao();
+            }
+            *link = right_rotation(node);
+        } else if (bal < -1) {
+            if (balance(node->right) > 0) { // Rotação dupla à direita-esquerda
+                m_stats.reestruturacao(2);
+                node->right = right_rotation(node->right);
+            } else { // Rotação simples à esquerda
+                m_stats.reestruturacao();
+            }
+            *link = left_rotation(node);
         }
+    }
 
-        node->height = std::max(height(node->left), height(node->right)) + 1;
-        int bal = balance(node); // Chama a versão const de balance
-
-        // Casos de rotação AVL
-        // Rotação simples à direita (LL case)
-        if (bal > 1 && compare(key, node->left->key)) {
-            m_rotations++;
-            return right_rotation(node);
-        }
-        // Rotação simples à esquerda (RR case)
-        if (bal < -1 && compare(node->right->key, key)) {
-            m_rotations++;
-            return left_rotation(node);
-        }
-        // Rotação dupla à esquerda-direita (LR case)
-        if (bal > 1 && compare(node->left->key, key)) { // key > node->left->key
-            m_rotations += 2;
-            node->left = left_rotation(node->left);
-            return right_rotation(node);
+    // Sobe pelo caminho caminho[topo - 1] ... caminho[0] atualizando alturas e rebalanceando.
+    // Para assim que uma subárvore termina com a mesma altura de antes: daí para cima nada muda.
+    void retracar(Link* caminho, int topo) {
+        while (topo > 0) {
+            Link link = caminho[--topo];
+            int antiga = (*link)->height;
+            (*link)->height = std::max(height((*link)->left), height((*link)->right)) + 1;
+            rebalancear(link);
+            if ((*link)->height == antiga) return;
         }
-        // Rotação dupla à direita-esquerda (RL case)
-        if (bal < -1 && compare(key, node->right->key)) { // key < node->right->key
-            m_rotations += 2;
-            node->right = right_rotation(node->right);
-            return left_rotation(node);
-        }
-        return node;
     }
 
-    // Função auxiliar recursiva para remover um elemento da árvore AVL e rebalancear.
-    AVLNode<KeyType, ValueType>* _erase(AVLNode<KeyType, ValueType>* node, const KeyType& key) {
-        if (!node) return nullptr;
-
-        m_comparisons++; // Comparação para decidir o caminho
-        if (compare(key, node->key)) { // key < node->key
-            node->left = _erase(node->left, key);
-        } else if (compare(node->key, key)) { // key > node->key
-            node->right = _erase(node->right, key);
-        } else {
-            // Elemento encontrado
-            // Caso 1: Nó sem filho ou com um filho
-            if (!node->left || !node->right) {
-                AVLNode<KeyType, ValueType>* temp = node->left ? node->left : node->right;
-                delete node;
-                size--;
-                return temp;
-            } else { // Caso 2: Nó com dois filhos
-                AVLNode<KeyType, ValueType>* temp = find_min(node->right); // Encontra o sucessor in-order
-                node->key = temp->key;
-                node->value = temp->value; // Copia o valor também
-                node->right = _erase(node->right, temp->key); // Remove o sucessor
+    // Inserção iterativa: desce guardando os links do caminho numa pilha e retorna o nó da chave.
+    // Chave existente não toca em alturas ('inserido' = false, o chamador decide o valor); chave
+    // nova entra com 'value' e sobe rebalanceando até a altura estabilizar (na inserção, isso
+    // acontece no máximo uma rotação depois). Rotações não mudam o endereço dos nós.
+    AVLNode<KeyType, ValueType>* _insert(const KeyType& key, const ValueType& value, bool& inserido) {
+        const PrefixoChave p = Comparador::prefixo(key);
+        Link caminho[ALTURA_MAXIMA];
+        int topo = 0;
+        Link link = &root;
+        while (*link) {
+            int c = comparar(key, p, *link); // Comparação para decidir o caminho
+            if (c == 0) { // Chave já existe: nada a rebalancear
+                inserido = false;
+                return *link;
             }
+            caminho[topo++] = link;
+            link = c < 0 ? &(*link)->left : &(*link)->right;
         }
+        AVLNode<KeyType, ValueType>* novo = new AVLNode<KeyType, ValueType>(key, value, p);
+        *link = novo;
+        size++;
+        retracar(caminho, topo);
+        inserido = true;
+        return novo;
+    }
 
-        if (!node) return node; // Se o nó se tornou nulo após a remoção (caso de folha)
-
-        node->height = std::max(height(node->left), height(node->right)) + 1;
-        int bal = balance(node); // Chama a versão const de balance
-
-        // Casos de rebalanceamento após a remoção
-        // Rotação simples à direita
-        if (bal > 1 && balance(node->left) >= 0) { // Chama a versão const de balance
-            m_rotations++;
-            return right_rotation(node);
-        }
-        // Rotação dupla à esquerda-direita
-        if (bal > 1 && balance(node->left) < 0) { // Chama a versão const de balance
-            m_rotations += 2;
-            node->left = left_rotation(node->left);
-            return right_rotation(node);
-        }
-        // Rotação simples à esquerda
-        if (bal < -1 && balance(node->right) <= 0) { // Chama a versão const de balance
-            m_rotations++;
-            return left_rotation(node);
+    // Remoção iterativa com a mesma pilha de links. Com dois filhos, a chave do sucessor in-order
+    // sobe para o nó e o sucessor (sem filho esquerdo) é que sai da árvore.
+    void _erase(const KeyType& key) {
+        const PrefixoChave p = Comparador::prefixo(key);
+        Link caminho[ALTURA_MAXIMA];
+        int topo = 0;
+        Link link = &root;
+        while (*link) {
+            int c = comparar(key, p, *link); // Comparação para decidir o caminho
+            if (c == 0) break;
+            caminho[topo++] = link;
+            link = c < 0 ? &(*link)->left : &(*link)->right;
         }
-        // Rotação dupla à direita-esquerda
-        if (bal < -1 && balance(node->right) > 0) { // Chama a versão const de balance
-            m_rotations += 2;
-            node->right = right_rotation(node->right);
-            return left_rotation(node);
+        if (!*link) return; // Chave não encontrada
+
+        AVLNode<KeyType, ValueType>* node = *link;
+        if (node->left && node->right) {
+            caminho[topo++] = link;
+            Link sucessor = &node->right;
+            while ((*sucessor)->left) {
+                caminho[topo++] = sucessor;
+                sucessor = &(*sucessor)->left;
+            }
+            node->key = (*sucessor)->key;
+            node->prefixo = (*sucessor)->prefixo; // O prefixo acompanha a chave
+            node->value = (*sucessor)->value;
+            link = sucessor;
+            node = *sucessor;
         }
-        return node;
+        *link = node->left ? node->left : node->right;
+        delete node;
+        size--;
+        ++m_versao;
+        retracar(caminho, topo);
     }
 
     // Função auxiliar recursiva para liberar a memória de todos os nós da árvore.
@@ -280,41 +324,34 @@ private:
     }
 
     // Função auxiliar recursiva para verificar se um elemento está na árvore.
-    bool _contains(AVLNode<KeyType, ValueType>* node, const KeyType& key) const {
+    bool _contains(AVLNode<KeyType, ValueType>* node, const KeyType& key, const PrefixoChave& p) const {
         if (!node) return false;
-        m_comparisons++; // Comparação
-        if (compare(key, node->key)) return _contains(node->left, key);
-        m_comparisons++; // Comparação
-        if (compare(node->key, key)) return _contains(node->right, key);
+        int c = comparar(key, p, node);
+        if (c < 0) return _contains(node->left, key, p);
+        if (c > 0) return _contains(node->right, key, p);
         return true; // key == node->key
     }
 
     // Encontra o nó com o menor valor na subárvore.
     AVLNode<KeyType, ValueType>* find_min(AVLNode<KeyType, ValueType>* node) const {
         if (!node) return nullptr;
-        while (node->left) {
-            m_comparisons++; // Comparação ao ir para a esquerda
-            node = node->left;
-        }
+        while (node->left) node = node->left;
         return node;
     }
 
     // Encontra o nó com o maior valor na subárvore.
     AVLNode<KeyType, ValueType>* find_max(AVLNode<KeyType, ValueType>* node) const {
         if (!node) return nullptr;
-        while (node->right) {
-            m_comparisons++; // Comparação ao ir para a direita
-            node = node->right;
-        }
+        while (node->right) node = node->right;
         return node;
     }
 
     // Encontra o sucessor de um elemento na árvore.
     AVLNode<KeyType, ValueType>* find_successor(AVLNode<KeyType, ValueType>* node, const KeyType& key) const {
+        const PrefixoChave p = Comparador::prefixo(key);
         AVLNode<KeyType, ValueType>* succ = nullptr;
         while (node) {
-            m_comparisons++; // Comparação
-            if (compare(key, node->key)) { // key < node->key
+            if (comparar(key, p, node) < 0) { // key < node->key
                 succ = node;
                 node = node->left;
             } else {
@@ -326,10 +363,10 @@ private:
 
     // Encontra o predecessor de um elemento na árvore.
     AVLNode<KeyType, ValueType>* find_predecessor(AVLNode<KeyType, ValueType>* node, const KeyType& key) const {
+        const PrefixoChave p = Comparador::prefixo(key);
         AVLNode<KeyType, ValueType>* pred = nullptr;
         while (node) {
-            m_comparisons++; // Comparação
-            if (compare(node->key, key)) { // node->key < key
+            if (comparar(key, p, node) > 0) { // node->key < key
                 pred = node;
                 node = node->right;
             } else {
@@ -355,6 +392,15 @@ private:
         in_order_collect(node->right, vec);
     }
 
+    // Percorre a árvore registrando o nível e o peso de cada nó.
+    template <typename Peso>
+    void shape_collect(AVLNode<KeyType, ValueType>* node, int nivel, Peso& peso, EstatisticasArvore& estatisticas) const {
+        if (!node) return;
+        estatisticas.registrar(nivel, static_cast<double>(peso(node->key, node->value)));
+        shape_collect(node->left, nivel + 1, peso, estatisticas);
+        shape_collect(node->right, nivel + 1, peso, estatisticas);
+    }
+
     // Exibe a estrutura da árvore de forma visual recursivamente.
     void bshow(AVLNode<KeyType, ValueType>* node, std::string heranca) const {
         if (node != nullptr && (node->left != nullptr || node->right != nullptr))
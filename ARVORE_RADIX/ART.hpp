@@ -0,0 +1,687 @@
+#ifndef ART_HPP
+#define ART_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility> // Para std::pair
+#include <vector>
+#include "../politica_estatisticas.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h> // Busca vetorizada no Node16
+#endif
+
+// Árvore Radix Adaptativa (ART) indexada por bytes de std::string.
+// Cada nível consome um byte da chave, então uma busca custa O(tamanho da chave)
+// em vez de O(log n) comparações completas de strings.
+// - Nós internos adaptativos: Node4, Node16, Node48 e Node256, escolhidos pelo número de filhos.
+// - Compressão de caminho: cada nó interno guarda o prefixo comum de todas as chaves abaixo dele.
+// - Expansão preguiçosa: uma folha guarda a chave inteira e fica no nível mais alto em que é única.
+// - Uma chave que termina exatamente num nó interno fica no ponteiro 'terminal' desse nó
+//   (ex.: "casa" quando também existe "casado").
+// O percurso em ordem (terminal primeiro, depois os filhos por byte crescente) produz a mesma
+// ordem lexicográfica de std::less<std::string>.
+// 'Stats' escolhe a instrumentação: CountingStats (nós visitados e crescimentos) ou NullStats (nenhuma).
+template <typename ValueType, typename Stats = CountingStats>
+class ArtTree {
+private:
+    enum class TipoNo : uint8_t { FOLHA, NO4, NO16, NO48, NO256 };
+
+    struct No {
+        TipoNo tipo;
+        explicit No(TipoNo t) : tipo(t) {}
+    };
+
+    struct Folha : No {
+        std::string chave; // Chave completa (permite a expansão preguiçosa)
+        ValueType valor;
+        Folha(const std::string& k, const ValueType& v) : No(TipoNo::FOLHA), chave(k), valor(v) {}
+    };
+
+    struct NoInterno : No {
+        uint16_t numFilhos = 0;
+        std::string prefixo;       // Prefixo comprimido compartilhado pelas chaves da subárvore
+        Folha* terminal = nullptr; // Chave que termina neste nó (após o prefixo)
+        explicit NoInterno(TipoNo t) : No(t) {}
+    };
+
+    // Node4 e Node16: chaves ordenadas e filhos em vetores paralelos.
+    struct No4 : NoInterno {
+        unsigned char chaves[4] = {};
+        No* filhos[4] = {};
+        No4() : NoInterno(TipoNo::NO4) {}
+    };
+
+    struct No16 : NoInterno {
+        unsigned char chaves[16] = {};
+        No* filhos[16] = {};
+        No16() : NoInterno(TipoNo::NO16) {}
+    };
+
+    // Node48: índice de 256 posições apontando para 48 slots (0 = vazio, i+1 = slot i).
+    struct No48 : NoInterno {
+        unsigned char indice[256] = {};
+        No* filhos[48] = {};
+        No48() : NoInterno(TipoNo::NO48) {}
+    };
+
+    // Node256: acesso direto pelo byte.
+    struct No256 : NoInterno {
+        No* filhos[256] = {};
+        No256() : NoInterno(TipoNo::NO256) {}
+    };
+
+    No* raiz = nullptr;
+    size_t m_size = 0;
+    // Nós visitados durante as descidas e trocas de um nó por uma variante maior (análogo das rotações).
+    Stats m_stats;
+
+    static bool ehFolha(const No* n) { return n->tipo == TipoNo::FOLHA; }
+
+    // Libera um nó chamando o destrutor do tipo concreto.
+    static void liberarNo(No* n) {
+        switch (n->tipo) {
+            case TipoNo::FOLHA: delete static_cast<Folha*>(n); break;
+            case TipoNo::NO4:   delete static_cast<No4*>(n); break;
+            case TipoNo::NO16:  delete static_cast<No16*>(n); break;
+            case TipoNo::NO48:  delete static_cast<No48*>(n); break;
+            case TipoNo::NO256: delete static_cast<No256*>(n); break;
+        }
+    }
+
+    // Procura o filho associado ao byte 'c'. Retorna o endereço do ponteiro para permitir substituição.
+    static No** encontrarFilho(NoInterno* n, unsigned char c) {
+        switch (n->tipo) {
+            case TipoNo::NO4: {
+                No4* no = static_cast<No4*>(n);
+                for (int i = 0; i < no->numFilhos; ++i)
+                    if (no->chaves[i] == c) return &no->filhos[i];
+                return nullptr;
+            }
+            case TipoNo::NO16: {
+                No16* no = static_cast<No16*>(n);
+#if defined(__SSE2__)
+                // Compara os 16 bytes de uma vez e mascara os slots não usados.
+                __m128i alvo = _mm_set1_epi8(static_cast<char>(c));
+                __m128i chaves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(no->chaves));
+                int bits = _mm_movemask_epi8(_mm_cmpeq_epi8(alvo, chaves)) & ((1 << no->numFilhos) - 1);
+                if (bits) return &no->filhos[__builtin_ctz(static_cast<unsigned>(bits))];
+                return nullptr;
+#else
+                for (int i = 0; i < no->numFilhos; ++i)
+                    if (no->chaves[i] == c) return &no->filhos[i];
+                return nullptr;
+#endif
+            }
+            case TipoNo::NO48: {
+                No48* no = static_cast<No48*>(n);
+                if (no->indice[c]) return &no->filhos[no->indice[c] - 1];
+                return nullptr;
+            }
+            case TipoNo::NO256: {
+                No256* no = static_cast<No256*>(n);
+                if (no->filhos[c]) return &no->filhos[c];
+                return nullptr;
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+    // Copia o cabeçalho (prefixo, terminal, número de filhos) de um nó interno para outro.
+    static void copiarCabecalho(NoInterno* destino, NoInterno* origem) {
+        destino->numFilhos = origem->numFilhos;
+        destino->prefixo = std::move(origem->prefixo);
+        destino->terminal = origem->terminal;
+    }
+
+    // Insere um novo filho no nó apontado por 'ref', trocando-o por uma variante maior se estiver cheio.
+    void adicionarFilho(No*& ref, unsigned char c, No* filho) {
+        NoInterno* n = static_cast<NoInterno*>(ref);
+        switch (n->tipo) {
+            case TipoNo::NO4: {
+                No4* no = static_cast<No4*>(n);
+                if (no->numFilhos < 4) {
+                    int pos = 0;
+                    while (pos < no->numFilhos && no->chaves[pos] < c) pos++;
+                    std::memmove(no->chaves + pos + 1, no->chaves + pos, no->numFilhos - pos);
+                    std::memmove(no->filhos + pos + 1, no->filhos + pos, (no->numFilhos - pos) * sizeof(No*));
+                    no->chaves[pos] = c;
+                    no->filhos[pos] = filho;
+                    no->numFilhos++;
+                    return;
+                }
+                No16* novo = new No16();
+                copiarCabecalho(novo, no);
+                std::memcpy(novo->chaves, no->chaves, 4);
+                std::memcpy(novo->filhos, no->filhos, 4 * sizeof(No*));
+                delete no;
+                ref = novo;
+                m_stats.reestruturacao();
+                adicionarFilho(ref, c, filho);
+                return;
+            }
+            case TipoNo::NO16: {
+                No16* no = static_cast<No16*>(n);
+                if (no->numFilhos < 16) {
+                    int pos = 0;
+                    while (pos < no->numFilhos && no->chaves[pos] < c) pos++;
+                    std::memmove(no->chaves + pos + 1, no->chaves + pos, no->numFilhos - pos);
+                    std::memmove(no->filhos + pos + 1, no->filhos + pos, (no->numFilhos - pos) * sizeof(No*));
+                    no->chaves[pos] = c;
+                    no->filhos[pos] = filho;
+                    no->numFilhos++;
+                    return;
+                }
+                No48* novo = new No48();
+                copiarCabecalho(novo, no);
+                for (int i = 0; i < 16; ++i) {
+                    novo->filhos[i] = no->filhos[i];
+                    novo->indice[no->chaves[i]] = static_cast<unsigned char>(i + 1);
+                }
+                delete no;
+                ref = novo;
+                m_stats.reestruturacao();
+                adicionarFilho(ref, c, filho);
+                return;
+            }
+            case TipoNo::NO48: {
+                No48* no = static_cast<No48*>(n);
+                if (no->numFilhos < 48) {
+                    int slot = 0;
+                    while (no->filhos[slot]) slot++; // Slots podem ficar livres após remoções
+                    no->filhos[slot] = filho;
+                    no->indice[c] = static_cast<unsigned char>(slot + 1);
+                    no->numFilhos++;
+                    return;
+                }
+                No256* novo = new No256();
+                copiarCabecalho(novo, no);
+                for (int b = 0; b < 256; ++b)
+                    if (no->indice[b]) novo->filhos[b] = no->filhos[no->indice[b] - 1];
+                delete no;
+                ref = novo;
+                m_stats.reestruturacao();
+                adicionarFilho(ref, c, filho);
+                return;
+            }
+            case TipoNo::NO256: {
+                No256* no = static_cast<No256*>(n);
+                no->filhos[c] = filho;
+                no->numFilhos++;
+                return;
+            }
+            default:
+                return;
+        }
+    }
+
+    // Remove o filho associado ao byte 'c' (o ponteiro já deve ter sido liberado ou reaproveitado).
+    static void removerFilho(NoInterno* n, unsigned char c) {
+        switch (n->tipo) {
+            case TipoNo::NO4:
+            case TipoNo::NO16: {
+                unsigned char* chaves = n->tipo == TipoNo::NO4 ? static_cast<No4*>(n)->chaves : static_cast<No16*>(n)->chaves;
+                No** filhos = n->tipo == TipoNo::NO4 ? static_cast<No4*>(n)->filhos : static_cast<No16*>(n)->filhos;
+                int pos = 0;
+                while (pos < n->numFilhos && chaves[pos] != c) pos++;
+                if (pos == n->numFilhos) return;
+                std::memmove(chaves + pos, chaves + pos + 1, n->numFilhos - pos - 1);
+                std::memmove(filhos + pos, filhos + pos + 1, (n->numFilhos - pos - 1) * sizeof(No*));
+                n->numFilhos--;
+                filhos[n->numFilhos] = nullptr;
+                return;
+            }
+            case TipoNo::NO48: {
+                No48* no = static_cast<No48*>(n);
+                if (!no->indice[c]) return;
+                no->filhos[no->indice[c] - 1] = nullptr;
+                no->indice[c] = 0;
+                no->numFilhos--;
+                return;
+            }
+            case TipoNo::NO256: {
+                No256* no = static_cast<No256*>(n);
+                if (!no->filhos[c]) return;
+                no->filhos[c] = nullptr;
+                no->numFilhos--;
+                return;
+            }
+            default:
+                return;
+        }
+    }
+
+    // Troca o nó interno apontado por 'ref' por uma variante menor quando sobram poucos filhos.
+    // Com 'histerese', usa os limites de encolhimento após remoções (No256 -> No48 com até 37
+    // filhos, No48 -> No16 com até 12, No16 -> No4 com até 3), abaixo dos de crescimento, para
+    // inserções e remoções alternadas não trocarem o nó a cada operação. Sem histerese, escolhe
+    // a menor variante em que os filhos cabem (usado por Compact).
+    static void encolher(No*& ref, bool histerese) {
+        NoInterno* n = static_cast<NoInterno*>(ref);
+        uint16_t f = n->numFilhos;
+        TipoNo alvo = n->tipo;
+        if (histerese) {
+            if (n->tipo == TipoNo::NO256 && f <= 37) alvo = TipoNo::NO48;
+            else if (n->tipo == TipoNo::NO48 && f <= 12) alvo = TipoNo::NO16;
+            else if (n->tipo == TipoNo::NO16 && f <= 3) alvo = TipoNo::NO4;
+        } else {
+            alvo = f <= 4 ? TipoNo::NO4 : f <= 16 ? TipoNo::NO16 : f <= 48 ? TipoNo::NO48 : TipoNo::NO256;
+        }
+        if (alvo >= n->tipo) return;
+
+        // Filhos em ordem crescente de byte (no máximo 48, já que o alvo é menor que No256).
+        unsigned char bytes[48];
+        No* filhos[48];
+        int k = 0;
+        switch (n->tipo) {
+            case TipoNo::NO16: {
+                No16* no = static_cast<No16*>(n);
+                for (; k < no->numFilhos; ++k) {
+                    bytes[k] = no->chaves[k];
+                    filhos[k] = no->filhos[k];
+                }
+                break;
+            }
+            case TipoNo::NO48: {
+                No48* no = static_cast<No48*>(n);
+                for (int b = 0; b < 256; ++b)
+                    if (no->indice[b]) {
+                        bytes[k] = static_cast<unsigned char>(b);
+                        filhos[k++] = no->filhos[no->indice[b] - 1];
+                    }
+                break;
+            }
+            case TipoNo::NO256: {
+                No256* no = static_cast<No256*>(n);
+                for (int b = 0; b < 256; ++b)
+                    if (no->filhos[b]) {
+                        bytes[k] = static_cast<unsigned char>(b);
+                        filhos[k++] = no->filhos[b];
+                    }
+                break;
+            }
+            default:
+                return;
+        }
+
+        NoInterno* novo = nullptr;
+        if (alvo == TipoNo::NO4 || alvo == TipoNo::NO16) {
+            unsigned char* chaves;
+            No** destino;
+            if (alvo == TipoNo::NO4) {
+                No4* no = new No4();
+                chaves = no->chaves;
+                destino = no->filhos;
+                novo = no;
+            } else {
+                No16* no = new No16();
+                chaves = no->chaves;
+                destino = no->filhos;
+                novo = no;
+            }
+            std::memcpy(chaves, bytes, k);
+            std::memcpy(destino, filhos, k * sizeof(No*));
+        } else {
+            No48* no = new No48();
+            for (int i = 0; i < k; ++i) {
+                no->filhos[i] = filhos[i];
+                no->indice[bytes[i]] = static_cast<unsigned char>(i + 1);
+            }
+            novo = no;
+        }
+        copiarCabecalho(novo, n);
+        liberarNo(n);
+        ref = novo;
+    }
+
+    // Encolhe todos os nós internos da subárvore para a menor variante que comporta seus filhos.
+    static void compactar(No*& ref) {
+        if (!ref || ehFolha(ref)) return;
+        encolher(ref, false);
+        paraCadaFilho(static_cast<NoInterno*>(ref), [](No*& filho) { compactar(filho); });
+    }
+
+    // Retorna o único filho de um nó com numFilhos == 1, junto com seu byte.
+    static std::pair<unsigned char, No*> unicoFilho(NoInterno* n) {
+        switch (n->tipo) {
+            case TipoNo::NO4:  return {static_cast<No4*>(n)->chaves[0], static_cast<No4*>(n)->filhos[0]};
+            case TipoNo::NO16: return {static_cast<No16*>(n)->chaves[0], static_cast<No16*>(n)->filhos[0]};
+            case TipoNo::NO48: {
+                No48* no = static_cast<No48*>(n);
+                for (int b = 0; b < 256; ++b)
+                    if (no->indice[b]) return {static_cast<unsigned char>(b), no->filhos[no->indice[b] - 1]};
+                break;
+            }
+            case TipoNo::NO256: {
+                No256* no = static_cast<No256*>(n);
+                for (int b = 0; b < 256; ++b)
+                    if (no->filhos[b]) return {static_cast<unsigned char>(b), no->filhos[b]};
+                break;
+            }
+            default:
+                break;
+        }
+        return {0, nullptr};
+    }
+
+    // Aplica 'func' aos filhos de um nó interno em ordem crescente de byte.
+    template <typename Funcao>
+    static void paraCadaFilho(NoInterno* n, Funcao&& func) {
+        switch (n->tipo) {
+            case TipoNo::NO4:
+                for (int i = 0; i < n->numFilhos; ++i) func(static_cast<No4*>(n)->filhos[i]);
+                break;
+            case TipoNo::NO16:
+                for (int i = 0; i < n->numFilhos; ++i) func(static_cast<No16*>(n)->filhos[i]);
+                break;
+            case TipoNo::NO48: {
+                No48* no = static_cast<No48*>(n);
+                for (int b = 0; b < 256; ++b)
+                    if (no->indice[b]) func(no->filhos[no->indice[b] - 1]);
+                break;
+            }
+            case TipoNo::NO256: {
+                No256* no = static_cast<No256*>(n);
+                for (int b = 0; b < 256; ++b)
+                    if (no->filhos[b]) func(no->filhos[b]);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    // Tamanho do prefixo comum entre 'a' (a partir de 'prof') e 'b' (a partir de 'prof').
+    static size_t prefixoComum(const std::string& a, const std::string& b, size_t prof) {
+        size_t limite = std::min(a.size(), b.size());
+        size_t i = prof;
+        while (i < limite && a[i] == b[i]) i++;
+        return i - prof;
+    }
+
+    // Posição do primeiro byte em que o prefixo do nó difere da chave (a partir de 'prof').
+    static size_t divergenciaPrefixo(const NoInterno* n, const std::string& key, size_t prof) {
+        size_t limite = std::min(n->prefixo.size(), key.size() - prof);
+        size_t i = 0;
+        while (i < limite && n->prefixo[i] == key[prof + i]) i++;
+        return i;
+    }
+
+    // Coloca uma folha sob um nó interno recém-criado, a partir da profundidade 'prof'.
+    void pendurarFolha(No*& ref, Folha* folha, size_t prof) {
+        NoInterno* n = static_cast<NoInterno*>(ref);
+        if (folha->chave.size() == prof) n->terminal = folha;
+        else adicionarFilho(ref, static_cast<unsigned char>(folha->chave[prof]), folha);
+    }
+
+    // Função auxiliar recursiva de inserção. 'ref' é o ponteiro (na raiz ou no pai) para o nó atual.
+    void _insert(No*& ref, const std::string& key, size_t prof, const ValueType& value) {
+        if (!ref) {
+            ref = new Folha(key, value);
+            m_size++;
+            return;
+        }
+
+        m_stats.comparacao();
+        if (ehFolha(ref)) {
+            Folha* folha = static_cast<Folha*>(ref);
+            if (folha->chave == key) { // Chave já existe, atualiza o valor
+                folha->valor = value;
+                return;
+            }
+            // Duas chaves distintas disputam a posição: cria um Node4 com o prefixo comum.
+            size_t lcp = prefixoComum(folha->chave, key, prof);
+            No4* novo = new No4();
+            novo->prefixo = key.substr(prof, lcp);
+            ref = novo;
+            pendurarFolha(ref, folha, prof + lcp);
+            pendurarFolha(ref, new Folha(key, value), prof + lcp);
+            m_size++;
+            return;
+        }
+
+        NoInterno* n = static_cast<NoInterno*>(ref);
+        size_t p = divergenciaPrefixo(n, key, prof);
+        if (p < n->prefixo.size()) {
+            // A chave diverge dentro do prefixo comprimido: divide o prefixo em um novo Node4.
+            No4* novo = new No4();
+            novo->prefixo = n->prefixo.substr(0, p);
+            unsigned char byteAntigo = static_cast<unsigned char>(n->prefixo[p]);
+            n->prefixo.erase(0, p + 1);
+            ref = novo;
+            adicionarFilho(ref, byteAntigo, n);
+            pendurarFolha(ref, new Folha(key, value), prof + p);
+            m_size++;
+            return;
+        }
+
+        prof += n->prefixo.size();
+        if (prof == key.size()) { // A chave termina neste nó
+            if (n->terminal) {
+                n->terminal->valor = value;
+            } else {
+                n->terminal = new Folha(key, value);
+                m_size++;
+            }
+            return;
+        }
+
+        unsigned char c = static_cast<unsigned char>(key[prof]);
+        No** filho = encontrarFilho(n, c);
+        if (filho) {
+            _insert(*filho, key, prof + 1, value);
+        } else {
+            adicionarFilho(ref, c, new Folha(key, value));
+            m_size++;
+        }
+    }
+
+    // Depois de uma remoção, colapsa nós internos que ficaram com uma única entrada.
+    void colapsar(No*& ref) {
+        NoInterno* n = static_cast<NoInterno*>(ref);
+        if (n->numFilhos == 0) {
+            // Só resta (talvez) o terminal: a folha sobe para o lugar do nó.
+            ref = n->terminal;
+            liberarNo(n);
+        } else if (n->numFilhos == 1 && !n->terminal) {
+            std::pair<unsigned char, No*> unico = unicoFilho(n);
+            if (!ehFolha(unico.second)) {
+                // Concatena os prefixos: prefixo do pai + byte do filho + prefixo do filho.
+                NoInterno* filho = static_cast<NoInterno*>(unico.second);
+                filho->prefixo = n->prefixo + static_cast<char>(unico.first) + filho->prefixo;
+            }
+            ref = unico.second;
+            liberarNo(n);
+        }
+    }
+
+    // Função auxiliar recursiva de remoção. Retorna true se a chave foi removida.
+    bool _erase(No*& ref, const std::string& key, size_t prof) {
+        if (!ref) return false;
+
+        m_stats.comparacao();
+        if (ehFolha(ref)) {
+            Folha* folha = static_cast<Folha*>(ref);
+            if (folha->chave != key) return false;
+            delete folha;
+            ref = nullptr;
+            m_size--;
+            return true;
+        }
+
+        NoInterno* n = static_cast<NoInterno*>(ref);
+        if (divergenciaPrefixo(n, key, prof) < n->prefixo.size()) return false;
+        prof += n->prefixo.size();
+
+        if (prof == key.size()) {
+            if (!n->terminal) return false;
+            delete n->terminal;
+            n->terminal = nullptr;
+            m_size--;
+            colapsar(ref);
+            return true;
+        }
+
+        unsigned char c = static_cast<unsigned char>(key[prof]);
+        No** filho = encontrarFilho(n, c);
+        if (!filho || !_erase(*filho, key, prof + 1)) return false;
+        if (!*filho) {
+            removerFilho(n, c);
+            encolher(ref, true);
+        }
+        colapsar(ref);
+        return true;
+    }
+
+    // Busca iterativa. Retorna a folha da chave ou nullptr.
+    Folha* _find(const std::string& key) const {
+        No* n = raiz;
+        size_t prof = 0;
+        while (n) {
+            m_stats.comparacao();
+            if (ehFolha(n)) {
+                // Os bytes [0, prof) já foram conferidos pelo caminho; compara apenas o restante.
+                Folha* folha = static_cast<Folha*>(n);
+                if (folha->chave.size() == key.size() &&
+                    folha->chave.compare(prof, std::string::npos, key, prof, std::string::npos) == 0)
+                    return folha;
+                return nullptr;
+            }
+            NoInterno* in = static_cast<NoInterno*>(n);
+            if (divergenciaPrefixo(in, key, prof) < in->prefixo.size()) return nullptr;
+            prof += in->prefixo.size();
+            if (prof == key.size()) return in->terminal;
+            No** filho = encontrarFilho(in, static_cast<unsigned char>(key[prof]));
+            if (!filho) return nullptr;
+            n = *filho;
+            prof++;
+        }
+        return nullptr;
+    }
+
+    // Percorre a subárvore em ordem lexicográfica aplicando 'func' a cada folha.
+    template <typename Funcao>
+    static void in_order(No* n, Funcao& func) {
+        if (!n) return;
+        if (ehFolha(n)) {
+            Folha* folha = static_cast<Folha*>(n);
+            func(folha->chave, folha->valor);
+            return;
+        }
+        NoInterno* in = static_cast<NoInterno*>(n);
+        if (in->terminal) func(in->terminal->chave, in->terminal->valor); // Prefixo vem antes das extensões
+        paraCadaFilho(in, [&func](No* filho) { in_order(filho, func); });
+    }
+
+    // Libera recursivamente todos os nós da subárvore.
+    static void destroy(No* n) {
+        if (!n) return;
+        if (!ehFolha(n)) {
+            NoInterno* in = static_cast<NoInterno*>(n);
+            if (in->terminal) delete in->terminal;
+            paraCadaFilho(in, [](No* filho) { destroy(filho); });
+        }
+        liberarNo(n);
+    }
+
+public:
+    ArtTree() = default;
+    ~ArtTree() { destroy(raiz); }
+    ArtTree(const ArtTree&) = delete;
+    ArtTree& operator=(const ArtTree&) = delete;
+
+    // Insere um par chave-valor. Se a chave já existe, atualiza seu valor.
+    void Insert(const std::string& key, const ValueType& value) {
+        _insert(raiz, key, 0, value);
+    }
+
+    // Remove uma chave da árvore.
+    void Erase(const std::string& key) {
+        _erase(raiz, key, 0);
+    }
+
+    // Verifica se uma chave está presente.
+    bool Contains(const std::string& key) const {
+        return _find(key) != nullptr;
+    }
+
+    // Retorna o valor associado à chave, ou ValueType{} se a chave não existir.
+    ValueType getCount(const std::string& key) const {
+        Folha* folha = _find(key);
+        return folha ? folha->valor : ValueType{};
+    }
+
+    // Remove todos os elementos.
+    void Clear() {
+        destroy(raiz);
+        raiz = nullptr;
+        m_size = 0;
+        m_stats.resetComparacoes();
+        m_stats.resetReestruturacoes();
+    }
+
+    // Troca cada nó interno pela menor variante que comporta seus filhos (ex.: um No256 que
+    // ficou com 20 filhos depois de remoções vira No48), devolvendo a memória que sobrou.
+    void Compact() {
+        compactar(raiz);
+    }
+
+    bool Empty() const { return raiz == nullptr; }
+    size_t Size() const { return m_size; }
+
+    // Percorre todos os pares em ordem lexicográfica.
+    void PrintInOrder(std::function<void(const std::string&, const ValueType&)> func) const {
+        in_order(raiz, func);
+    }
+
+    // Retorna todos os pares em ordem lexicográfica.
+    std::vector<std::pair<std::string, ValueType>> ToVector() const {
+        std::vector<std::pair<std::string, ValueType>> result;
+        result.reserve(m_size);
+        auto coletar = [&result](const std::string& k, const ValueType& v) { result.emplace_back(k, v); };
+        in_order(raiz, coletar);
+        return result;
+    }
+
+    // Aplica 'func' a todas as chaves que começam com 'prefixo', em ordem lexicográfica.
+    // O custo da descida é proporcional ao tamanho do prefixo, não ao número de chaves.
+    void ForEachWithPrefix(const std::string& prefixo, std::function<void(const std::string&, const ValueType&)> func) const {
+        No* n = raiz;
+        size_t prof = 0;
+        while (n) {
+            m_stats.comparacao();
+            if (ehFolha(n)) {
+                // Folhas preguiçosas podem estar acima do fim do prefixo: confere a chave inteira.
+                Folha* folha = static_cast<Folha*>(n);
+                if (folha->chave.compare(0, prefixo.size(), prefixo) == 0) func(folha->chave, folha->valor);
+                return;
+            }
+            NoInterno* in = static_cast<NoInterno*>(n);
+            size_t restante = prefixo.size() - prof;
+            size_t m = std::min(in->prefixo.size(), restante);
+            if (in->prefixo.compare(0, m, prefixo, prof, m) != 0) return;
+            if (in->prefixo.size() >= restante) { // Prefixo consumido: toda a subárvore casa
+                in_order(n, func);
+                return;
+            }
+            prof += in->prefixo.size();
+            No** filho = encontrarFilho(in, static_cast<unsigned char>(prefixo[prof]));
+            if (!filho) return;
+            n = *filho;
+            prof++;
+        }
+    }
+
+    // Métodos para acessar as métricas
+    long long getComparacoesPrincipais() const { return m_stats.comparacoes(); }
+    long long getCrescimentos() const { return m_stats.reestruturacoes(); }
+    void resetComparacoes() { m_stats.resetComparacoes(); }
+    void resetCrescimentos() { m_stats.resetReestruturacoes(); }
+};
+
+#endif // ART_HPP
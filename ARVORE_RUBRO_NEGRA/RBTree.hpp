@@ -6,6 +6,9 @@
 #include <utility>    // Para std::pair
 #include <vector>     // Para std::vector em inorderCollect
 #include <functional> // Para std::function
+#include "../estatisticas_arvore.hpp"
+#include "../politica_estatisticas.hpp"
+#include "../prefixo_chave.hpp"
 
 // Definições de cores para os nós da árvore
 #define RED true
@@ -16,6 +19,7 @@ template <typename T> // T será std::pair<Key, Value>
 struct RBNode {
     bool color;       // Cor do nó (RED ou BLACK)
     T key_value;      // O par (chave, valor) armazenado no nó
+    PrefixoChave prefixo; // 8 primeiros bytes e tamanho da chave (decide a maioria das comparações)
     int ocorrencias;  // Contador de ocorrências do elemento
 
     RBNode *left;     // Ponteiro para o filho esquerdo
@@ -23,8 +27,8 @@ struct RBNode {
     RBNode *parent;   // Ponteiro para o pai
 
     // Construtor do nó
-    RBNode(const T& kv, bool c, RBNode* l, RBNode* r, RBNode* p)
-        : color(c), key_value(kv), ocorrencias(1), left(l), right(r), parent(p) {}
+    RBNode(const T& kv, bool c, RBNode* l, RBNode* r, RBNode* p, const PrefixoChave& pre = PrefixoChave())
+        : color(c), key_value(kv), prefixo(pre), ocorrencias(1), left(l), right(r), parent(p) {}
 
     // Removido o destrutor com cout, pois em grandes árvores isso causa muito output.
     // Se precisar para depuração, pode recolocá-lo temporariamente.
@@ -34,7 +38,8 @@ struct RBNode {
 };
 
 // Classe da Árvore Rubro-Negra
-template <typename Key, typename Value>
+// 'Stats' escolhe a instrumentação: CountingStats (comparações e rotações) ou NullStats (nenhuma).
+template <typename Key, typename Value, typename Stats = CountingStats>
 class rbtree {
 private:
     using Pair = std::pair<Key, Value>; // Alias para o tipo de par
@@ -42,8 +47,20 @@ private:
     RBNode<Pair>* root; // Raiz da árvore
     RBNode<Pair>* nil;  // Nó sentinela (NIL)
 
-    mutable long long comparacoes_principais = 0; // Contador de comparações (mutable para const methods)
-    long long comparacoes_rotacoes = 0;           // Contador de rotações
+    Stats m_stats; // Contadores de comparações e rotações (vazio com NullStats)
+    size_t m_versao = 0; // nós liberados por remove e clears (ver versao())
+
+    using Comparador = ComparadorPrefixo<Key>;
+    Comparador m_comparador; // Comparação em três vias pelo prefixo, com desempate pela chave
+
+    // < 0, 0 ou > 0 conforme 'key' (de prefixo 'p') vem antes, é igual ou vem depois da chave do nó.
+    // Só o caminho lento (prefixos empatados) lê as chaves e conta como comparação.
+    int comparar(const Key& key, const PrefixoChave& p, const RBNode<Pair>* node) const {
+        int resultado;
+        if (Comparador::decide(p, node->prefixo, resultado)) return resultado;
+        m_stats.comparacao();
+        return m_comparador.comparar(key, node->key_value.first);
+    }
 
     // Função auxiliar para criar e inicializar o nó NIL
     RBNode<Pair>* create_nil_node() {
@@ -54,7 +71,7 @@ private:
 
     // Funções de rotação
     void leftRotate(RBNode<Pair>* x) {
-        comparacoes_rotacoes++; // Incrementa contador de rotações
+        m_stats.reestruturacao(); // Incrementa contador de rotações
         RBNode<Pair>* y = x->right;
         x->right = y->left;
         if (y->left != nil) {
@@ -73,7 +90,7 @@ private:
     }
 
     void rightRotate(RBNode<Pair>* y) {
-        comparacoes_rotacoes++; // Incrementa contador de rotações
+        m_stats.reestruturacao(); // Incrementa contador de rotações
         RBNode<Pair>* x = y->left;
         y->left = x->right;
         if (x->right != nil) {
@@ -223,11 +240,12 @@ private:
 
     // Busca interna que retorna o nó, ou nil se não encontrado
     RBNode<Pair>* search(RBNode<Pair>* node, const Key& key) const {
+        const PrefixoChave p = Comparador::prefixo(key);
         while (node != nil) {
-            comparacoes_principais++; // Incrementa o contador de comparações.
-            if (key == node->key_value.first)
+            int c = comparar(key, p, node);
+            if (c == 0)
                 return node;
-            if (key < node->key_value.first)
+            if (c < 0)
                 node = node->left;
             else
                 node = node->right;
@@ -235,6 +253,60 @@ private:
         return nil; // Chave não encontrada.
     }
 
+    // Desce até a chave e retorna o seu nó. Se ela não existir, cria um nó VERMELHO com
+    // (key, value) e uma ocorrência, rebalanceia e retorna o novo nó ('inserido' = true).
+    RBNode<Pair>* insertNode(const Key& key, const Value& value, bool& inserido) {
+        const PrefixoChave p = Comparador::prefixo(key);
+        RBNode<Pair>* parent = nil;
+        RBNode<Pair>* current = root;
+        int c = 0; // Resultado da última comparação: lado do novo nó sob 'parent'
+
+        // Percorre a árvore para encontrar o local de inserção ou a chave existente.
+        while (current != nil) {
+            parent = current;
+            c = comparar(key, p, current);
+            if (c == 0) {
+                inserido = false;
+                return current;
+            }
+            if (c < 0) {
+                current = current->left;
+            } else {
+                current = current->right;
+            }
+        }
+
+        // Cria o novo nó, com a cor VERMELHA e ocorrências = 1.
+        RBNode<Pair>* newNode = new RBNode<Pair>(Pair(key, value), RED, nil, nil, parent, p);
+        newNode->ocorrencias = 1; // Garante que novas inserções iniciem com 1 ocorrência
+
+        // Conecta o novo nó ao seu pai.
+        if (parent == nil) {
+            root = newNode;
+        } else if (c < 0) {
+            parent->left = newNode;
+        } else {
+            parent->right = newNode;
+        }
+
+        insertFixup(newNode); // Chama a função para corrigir as propriedades da Árvore Vermelho-Preta.
+        inserido = true;
+        return newNode;
+    }
+
+    // Registra nível e ocorrências de cada nó e retorna a altura negra da subárvore
+    // (nós pretos até a folha NIL, sem contar o próprio nó).
+    int shapeCollect(RBNode<Pair>* node, int nivel, EstatisticasArvore& estatisticas) const {
+        if (node == nil) return 0;
+        estatisticas.registrar(nivel, static_cast<double>(node->ocorrencias));
+        int esquerda = shapeCollect(node->left, nivel + 1, estatisticas);
+        int direita = shapeCollect(node->right, nivel + 1, estatisticas);
+        if (node->left != nil && node->left->color == BLACK) esquerda++;
+        if (node->right != nil && node->right->color == BLACK) direita++;
+        if (esquerda != direita) estatisticas.altura_negra_uniforme = false;
+        return esquerda;
+    }
+
     // *** CORREÇÃO NA FUNÇÃO bshow_internal ***
     // Esta versão tenta desenhar a árvore de forma mais tradicional (esquerda-direita, de cima para baixo).
     void bshow_internal(RBNode<Pair>* node, std::string prefix, bool is_left) const {
@@ -279,39 +351,21 @@ public:
 
     // Insere uma chave e um valor (considerando a frequência/ocorrência)
     void insert(const Key& key, const Value& value) {
-        RBNode<Pair>* parent = nil;
-        RBNode<Pair>* current = root;
-
-        // Percorre a árvore para encontrar o local de inserção ou a chave existente.
-        while (current != nil) {
-            parent = current;
-            comparacoes_principais++; // Incrementa o contador de comparações
-            if (key == current->key_value.first) { // Se a chave já existe, atualiza o valor e incrementa ocorrências
-                current->key_value.second = value; // Atualiza o valor
-                current->ocorrencias++;      // Incrementa ocorrências
-                return;
-            }
-            if (key < current->key_value.first) {
-                current = current->left;
-            } else {
-                current = current->right;
-            }
-        }
-
-        // Cria o novo nó, com a cor VERMELHA e ocorrências = 1.
-        RBNode<Pair>* newNode = new RBNode<Pair>(Pair(key, value), RED, nil, nil, parent);
-        newNode->ocorrencias = 1; // Garante que novas inserções iniciem com 1 ocorrência
-
-        // Conecta o novo nó ao seu pai.
-        if (parent == nil) {
-            root = newNode;
-        } else if (key < parent->key_value.first) {
-            parent->left = newNode;
-        } else {
-            parent->right = newNode;
+        bool inserido;
+        RBNode<Pair>* node = insertNode(key, value, inserido);
+        if (!inserido) { // Se a chave já existe, atualiza o valor e incrementa ocorrências
+            node->key_value.second = value;
+            node->ocorrencias++;
         }
+    }
 
-        insertFixup(newNode); // Chama a função para corrigir as propriedades da Árvore Vermelho-Preta.
+    // Nó da chave, inserida com Value() e zero ocorrências se ainda não existir (uma só descida).
+    // Os nós não mudam de endereço nas rotações; só a remoção do próprio nó (ou clear) os libera.
+    RBNode<Pair>* findOrInsert(const Key& key) {
+        bool inserido;
+        RBNode<Pair>* node = insertNode(key, Value(), inserido);
+        if (inserido) node->ocorrencias = 0;
+        return node;
     }
 
     // Remove uma chave. Se tiver mais de uma ocorrência, decrementa o contador. Se for 1, remove o nó.
@@ -356,19 +410,25 @@ public:
         }
 
         delete z; // Libera o nó original
+        ++m_versao;
 
         if (y_original_color == BLACK) {
             removeFixup(x);
         }
     }
 
+    // Muda sempre que um nó é liberado (remove da última ocorrência, clear): ponteiros obtidos
+    // com findOrInsert antes disso podem não valer mais.
+    size_t versao() const { return m_versao; }
+
     // Limpa todos os elementos da árvore, tornando-a vazia.
     void clear() {
         clearInternal(root);
         root = nil; // A raiz volta a ser o nó nil
+        ++m_versao;
         // Resetar contadores ao limpar
-        comparacoes_principais = 0;
-        comparacoes_rotacoes = 0;
+        m_stats.resetComparacoes();
+        m_stats.resetReestruturacoes();
     }
 
     // Verifica se uma chave está presente na árvore.
@@ -389,14 +449,25 @@ public:
         return root == nil;
     }
 
-    // Retorna o número de comparações principais realizadas.
-    long long getComparacoesPrincipais() const { return comparacoes_principais; }
+    // Retorna o número de comparações principais realizadas
+    // (desempates que precisaram das chaves completas, com prefixos de 8 bytes iguais).
+    long long getComparacoesPrincipais() const { return m_stats.comparacoes(); }
     // Retorna o número de rotações realizadas.
-    long long getRotacoes() const { return comparacoes_rotacoes; }
+    long long getRotacoes() const { return m_stats.reestruturacoes(); }
     // Reseta o contador de comparações principais.
-    void resetComparacoes() { comparacoes_principais = 0; }
+    void resetComparacoes() { m_stats.resetComparacoes(); }
     // Reseta o contador de rotações.
-    void resetRotacoes() { comparacoes_rotacoes = 0; }
+    void resetRotacoes() { m_stats.resetReestruturacoes(); }
+
+    // Calcula a forma da árvore: altura, altura negra, nós por nível e caminhos de busca
+    // ponderados pelas ocorrências de cada chave.
+    EstatisticasArvore estatisticasForma() const {
+        EstatisticasArvore estatisticas;
+        estatisticas.rubro_negra = true;
+        // A altura negra da raiz conta a própria raiz (sempre preta).
+        if (root != nil) estatisticas.altura_negra = shapeCollect(root, 1, estatisticas) + 1;
+        return estatisticas;
+    }
 
     // Função para coletar todos os pares em ordem crescente (para uso externo).
     // Preenche um vetor com todos os elementos da árvore, incluindo as ocorrências.
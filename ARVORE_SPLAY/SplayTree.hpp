@@ -0,0 +1,268 @@
+#ifndef SPLAY_TREE_HPP
+#define SPLAY_TREE_HPP
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../estatisticas_arvore.hpp"
+#include "../politica_estatisticas.hpp"
+#include "../prefixo_chave.hpp"
+
+template <typename Key, typename Value>
+struct SplayNode {
+    Key key;
+    Value value;
+    PrefixoChave prefixo; // 8 primeiros bytes e tamanho da chave (decide a maioria das comparações)
+    SplayNode* left;
+    SplayNode* right;
+
+    SplayNode(const Key& k, const Value& v, const PrefixoChave& p)
+        : key(k), value(v), prefixo(p), left(nullptr), right(nullptr) {}
+};
+
+// Árvore splay (Sleator e Tarjan): toda busca, inserção ou remoção traz a chave acessada
+// para a raiz. Sem balanceamento explícito, o custo amortizado é O(log n) e as chaves mais
+// acessadas ficam perto da raiz, o que favorece textos com frequências muito desiguais
+// (as palavras mais comuns são alcançadas em poucos passos).
+// - Splay top-down: uma única descida, sem ponteiro para o pai nem pilha.
+// - Buscas também reestruturam a árvore, por isso find/count/contains não são const.
+// - A árvore pode ficar degenerada (ex.: chaves inseridas em ordem), então os percursos
+//   (destruição, coleta em ordem, forma) são iterativos.
+// 'Stats' escolhe a instrumentação: CountingStats (comparações e rotações) ou NullStats (nenhuma).
+template <typename Key, typename Value, typename Stats = CountingStats>
+class SplayTree {
+public:
+    using Node = SplayNode<Key, Value>;
+
+    SplayTree() = default;
+    SplayTree(const SplayTree&) = delete;
+    SplayTree& operator=(const SplayTree&) = delete;
+    ~SplayTree() { destroy(); }
+
+    // Insere a chave ou atualiza o valor se ela já existe; a chave termina na raiz.
+    void insert(const Key& key, const Value& value) {
+        const PrefixoChave p = Comparador::prefixo(key);
+        if (!root) {
+            root = new Node(key, value, p);
+            m_size++;
+            return;
+        }
+        int c = splay(key, p);
+        if (c == 0) {
+            root->value = value;
+            return;
+        }
+        // A raiz é vizinha da chave na ordem: divide a árvore em volta do novo nó.
+        Node* novo = new Node(key, value, p);
+        if (c < 0) {
+            novo->left = root->left;
+            novo->right = root;
+            root->left = nullptr;
+        } else {
+            novo->right = root->right;
+            novo->left = root;
+            root->right = nullptr;
+        }
+        root = novo;
+        m_size++;
+    }
+
+    // Remove a chave. Retorna false se ela não existir.
+    bool remove(const Key& key) {
+        if (!root) return false;
+        const PrefixoChave p = Comparador::prefixo(key);
+        if (splay(key, p) != 0) return false;
+        Node* removido = root;
+        if (!root->left) {
+            root = root->right;
+        } else {
+            // Todas as chaves da esquerda são menores: o splay leva a maior delas à raiz,
+            // que fica sem filho direito e recebe a subárvore direita.
+            Node* direita = root->right;
+            root = root->left;
+            splay(key, p);
+            root->right = direita;
+        }
+        delete removido;
+        m_size--;
+        return true;
+    }
+
+    // Ponteiro para o valor da chave (trazida para a raiz) ou nullptr se ela não existir.
+    Value* find(const Key& key) {
+        if (!root) return nullptr;
+        return splay(key, Comparador::prefixo(key)) == 0 ? &root->value : nullptr;
+    }
+
+    bool contains(const Key& key) { return find(key) != nullptr; }
+
+    // Valor associado à chave ou Value() se ela não existir.
+    Value count(const Key& key) {
+        Value* valor = find(key);
+        return valor ? *valor : Value();
+    }
+
+    void clear() {
+        destroy();
+        m_stats.resetComparacoes();
+        m_stats.resetReestruturacoes();
+    }
+
+    bool empty() const { return root == nullptr; }
+    size_t size() const { return m_size; }
+
+    // Coleta os pares (chave, valor) em ordem crescente de chave.
+    void inorderCollect(std::vector<std::pair<Key, Value>>& out) const {
+        out.clear();
+        out.reserve(m_size);
+        std::vector<const Node*> pilha;
+        const Node* node = root;
+        while (node || !pilha.empty()) {
+            while (node) {
+                pilha.push_back(node);
+                node = node->left;
+            }
+            node = pilha.back();
+            pilha.pop_back();
+            out.emplace_back(node->key, node->value);
+            node = node->right;
+        }
+    }
+
+    // Forma atual da árvore; 'peso(chave, valor)' dá a frequência de acesso de cada nó.
+    template <typename Peso>
+    EstatisticasArvore estatisticasForma(Peso peso) const {
+        EstatisticasArvore estatisticas;
+        std::vector<std::pair<const Node*, int>> pilha;
+        if (root) pilha.emplace_back(root, 1);
+        while (!pilha.empty()) {
+            auto [node, nivel] = pilha.back();
+            pilha.pop_back();
+            estatisticas.registrar(nivel, static_cast<double>(peso(node->key, node->value)));
+            if (node->left) pilha.emplace_back(node->left, nivel + 1);
+            if (node->right) pilha.emplace_back(node->right, nivel + 1);
+        }
+        return estatisticas;
+    }
+
+    // Exibe a árvore deitada (direita em cima), para depuração.
+    void bshow() const { bshow(root, ""); }
+
+    // Comparações = desempates que precisaram das chaves completas (prefixos de 8 bytes iguais).
+    // Rotações = passos do splay: cada rotação zig-zig/zag-zag e cada nó ligado às árvores
+    // laterais (equivale a uma rotação do splay bottom-up).
+    long long getComparacoesPrincipais() const { return m_stats.comparacoes(); }
+    long long getRotacoes() const { return m_stats.reestruturacoes(); }
+    void resetComparacoes() { m_stats.resetComparacoes(); }
+    void resetRotacoes() { m_stats.resetReestruturacoes(); }
+
+private:
+    Node* root{nullptr};
+    size_t m_size{0};
+    Stats m_stats; // Contadores de comparações e rotações (vazio com NullStats)
+
+    using Comparador = ComparadorPrefixo<Key>;
+    Comparador m_comparador; // Comparação em três vias pelo prefixo, com desempate pela chave
+
+    // < 0, 0 ou > 0 conforme 'key' (de prefixo 'p') vem antes, é igual ou vem depois da chave do nó.
+    // Só o caminho lento (prefixos empatados) lê as chaves e conta como comparação.
+    int comparar(const Key& key, const PrefixoChave& p, const Node* node) const {
+        int resultado;
+        if (Comparador::decide(p, node->prefixo, resultado)) return resultado;
+        m_stats.comparacao();
+        return m_comparador.comparar(key, node->key);
+    }
+
+    // Splay top-down: traz para a raiz a chave ou, se ela não existir, o último nó visitado
+    // (seu antecessor ou sucessor na ordem). Retorna a comparação de 'key' com a nova raiz.
+    // Os nós deixados para trás formam duas árvores laterais: 'menores' (ligados pelo filho
+    // direito do seu maior nó) e 'maiores' (ligados pelo filho esquerdo do seu menor nó).
+    int splay(const Key& key, const PrefixoChave& p) {
+        Node* menores = nullptr;
+        Node* maiores = nullptr;
+        Node** fim_menores = &menores;
+        Node** fim_maiores = &maiores;
+        Node* t = root;
+        int c = comparar(key, p, t);
+        while (c != 0) {
+            if (c < 0) {
+                if (!t->left) break;
+                int c_filho = comparar(key, p, t->left);
+                if (c_filho < 0) { // zig-zig: rotação à direita antes de ligar
+                    Node* y = t->left;
+                    t->left = y->right;
+                    y->right = t;
+                    t = y;
+                    m_stats.reestruturacao();
+                    if (!t->left) {
+                        c = c_filho;
+                        break;
+                    }
+                }
+                // Liga 't' (e sua subárvore direita) às maiores
+                *fim_maiores = t;
+                fim_maiores = &t->left;
+                t = t->left;
+                m_stats.reestruturacao();
+                c = (c_filho < 0) ? comparar(key, p, t) : c_filho;
+            } else {
+                if (!t->right) break;
+                int c_filho = comparar(key, p, t->right);
+                if (c_filho > 0) { // zag-zag: rotação à esquerda antes de ligar
+                    Node* y = t->right;
+                    t->right = y->left;
+                    y->left = t;
+                    t = y;
+                    m_stats.reestruturacao();
+                    if (!t->right) {
+                        c = c_filho;
+                        break;
+                    }
+                }
+                // Liga 't' (e sua subárvore esquerda) às menores
+                *fim_menores = t;
+                fim_menores = &t->right;
+                t = t->right;
+                m_stats.reestruturacao();
+                c = (c_filho > 0) ? comparar(key, p, t) : c_filho;
+            }
+        }
+        // Monta a nova raiz: os filhos de 't' completam as árvores laterais.
+        *fim_menores = t->left;
+        *fim_maiores = t->right;
+        t->left = menores;
+        t->right = maiores;
+        root = t;
+        return c;
+    }
+
+    // Libera os nós sem recursão: rotaciona à direita até o nó não ter filho esquerdo.
+    void destroy() {
+        Node* node = root;
+        while (node) {
+            if (node->left) {
+                Node* esquerdo = node->left;
+                node->left = esquerdo->right;
+                esquerdo->right = node;
+                node = esquerdo;
+            } else {
+                Node* direito = node->right;
+                delete node;
+                node = direito;
+            }
+        }
+        root = nullptr;
+        m_size = 0;
+    }
+
+    void bshow(const Node* node, const std::string& prefixo) const {
+        if (!node) return;
+        bshow(node->right, prefixo + "    ");
+        std::cout << prefixo << node->key << ":" << node->value << "\n";
+        bshow(node->left, prefixo + "    ");
+    }
+};
+
+#endif // SPLAY_TREE_HPP
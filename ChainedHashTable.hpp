@@ -2,99 +2,160 @@
 #define CHAINEDHASHTABLE_HPP
 
 #include <iostream>
-#include <cmath>
 #include <string>
 #include <list>
 #include <vector>
 #include <utility>
 #include <functional> // Para std::hash
 #include <algorithm>  // Para std::move
+#include <iterator>   // Para std::prev
+#include "estatisticas_hash.hpp"
+#include "tamanho_primo.hpp"
+#include "politica_estatisticas.hpp"
 
 // A função de hash para o par não é mais usada diretamente para o hash do bucket,
 // já que a tabela agora funciona como um mapa KeyType -> ValueType.
 // A função de hash será baseada apenas na KeyType.
 
-template <typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>>
+// Políticas de reordenação das cadeias, aplicadas quando 'add' encontra a chave (acerto).
+// Com frequências desiguais (Zipf), as chaves quentes passam a ficar no início das listas e
+// deixam de pagar pelas chaves frias inseridas antes delas.
+// - OrdemInsercao: não mexe na lista (comportamento original).
+// - MoverParaFrente: a chave encontrada vai para o início da lista (adapta-se rápido).
+// - Transpor: a chave troca de lugar com a anterior (sobe aos poucos, mais estável).
+// Só religam nós da std::list (splice): nenhuma chave é copiada.
+struct OrdemInsercao {
+    static constexpr const char* nome = "insertion"; // Valor de --chain-order
+
+    template <typename Lista>
+    static void acerto(Lista&, typename Lista::iterator) {}
+};
+
+struct MoverParaFrente {
+    static constexpr const char* nome = "mtf"; // Valor de --chain-order
+
+    template <typename Lista>
+    static void acerto(Lista& lista, typename Lista::iterator it) {
+        if (it != lista.begin()) lista.splice(lista.begin(), lista, it);
+    }
+};
+
+struct Transpor {
+    static constexpr const char* nome = "transpose"; // Valor de --chain-order
+
+    template <typename Lista>
+    static void acerto(Lista& lista, typename Lista::iterator it) {
+        if (it != lista.begin()) lista.splice(std::prev(it), lista, it);
+    }
+};
+
+// 'Reordenacao' escolhe a política das cadeias (OrdemInsercao, MoverParaFrente ou Transpor).
+// 'Stats' escolhe a instrumentação: CountingStats (comparações e rehashes) ou NullStats (nenhuma).
+template <typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>,
+          typename Reordenacao = OrdemInsercao, typename Stats = CountingStats>
 class ChainedHashTable {
 private:
     // Estrutura interna para armazenar cada elemento na tabela hash.
     struct Elemento {
         KeyType key;    // A chave do elemento.
         ValueType value; // O valor associado à chave (frequência, por exemplo).
-        // Construtor que inicializa a chave e o valor.
-        Elemento(const KeyType& k, const ValueType& v) : key(k), value(v) {}
+        size_t hash;     // Hash completo da chave: evita recalcular no rehash e filtra comparações de chave.
+        // Construtor que inicializa a chave, o valor e o hash.
+        Elemento(const KeyType& k, const ValueType& v, size_t h) : key(k), value(v), hash(h) {}
     };
 
     size_t m_number_of_elements = 0; // Número total de elementos únicos na tabela.
     size_t m_table_size;             // Tamanho atual da tabela (número de buckets).
+    TamanhoPrimo m_tamanho;          // Primo da escada usado como tamanho e sua redução rápida (fastmod).
     float m_max_load_factor;         // Fator de carga máximo permitido antes de um rehash.
     std::vector<std::list<Elemento>> m_table; // A tabela hash, implementada como um vetor de listas (encadeamento).
     Hash m_hashing;                          // Objeto de função hash para calcular os códigos hash.
 
-    long long comparacoes_principal = 0; // Contador para o número de comparações de chaves realizadas.
-    long long contador_rehash = 0;       // Contador para o número de operações de rehash realizadas.
-
-    // Retorna o próximo número primo maior ou igual a 'x'.
-    // Usado para garantir que o tamanho da tabela seja um número primo, o que ajuda a distribuir melhor os hashes.
-    size_t get_next_prime(size_t x) {
-        if(x <= 2) return 3; // Os primeiros primos são 2, 3. Se x for 0, 1 ou 2, retorna 3.
-        x = (x % 2 == 0) ? x + 1 : x; // Garante que 'x' seja ímpar para otimizar a verificação.
-        bool not_prime = true;
-        while(not_prime) {
-            not_prime = false;
-            // Itera apenas sobre números ímpares até a raiz quadrada de 'x' para verificar a primalidade.
-            for(int i = 3; i <= sqrt(x); i += 2) {
-                if(x % i == 0) { // Se 'x' for divisível por 'i', não é primo.
-                    not_prime = true;
-                    break;
-                }
-            }
-            x += 2; // Tenta o próximo número ímpar.
-        }
-        return x - 2; // Retorna o primo encontrado.
+    Stats m_stats; // Contadores de comparações de chaves e de rehashes (vazio com NullStats).
+    size_t m_versao = 0; // remoções (ver versao())
+
+    // A tabela encolhe quando uma remoção deixa o fator de carga abaixo de 1/4 do máximo
+    // (o novo tamanho deixa a carga na metade do máximo), mas nunca abaixo do tamanho padrão.
+    static constexpr float FRACAO_ENCOLHIMENTO = 0.25f;
+    static constexpr size_t TAMANHO_MINIMO = 19;
+
+    // Mapeia o hash completo para um bucket (h % m_table_size sem instrução de divisão).
+    size_t slot_de(size_t h) const {
+        return m_tamanho.reduzir(h);
     }
 
-    // Calcula o código hash para uma dada chave e mapeia-o para um slot na tabela.
-    size_t hash_code(const KeyType& key) const {
-        return m_hashing(key) % m_table_size; // Aplica a função hash e usa o módulo para obter o índice do bucket.
+    // Menor número de buckets com que 'n' elementos ficam abaixo do fator de carga máximo.
+    size_t minimo_para(size_t n) const {
+        return static_cast<size_t>(n / m_max_load_factor) + 1;
     }
 
-public:
-    // Construtor da tabela hash.
-    // Inicializa o tamanho da tabela com um primo e define o fator de carga máximo.
-    ChainedHashTable(size_t tableSize = 19, float load_factor = 1.0) {
-        m_table_size = get_next_prime(tableSize); // Define o tamanho da tabela para o próximo primo.
-        m_table.resize(m_table_size);             // Redimensiona o vetor para o tamanho da tabela.
-        // Garante que o fator de carga seja um valor positivo.
-        m_max_load_factor = (load_factor <= 0) ? 1.0f : load_factor;
+    // Passa a tabela para o primo da escada >= 'tamanho', descartando o conteúdo.
+    void alocar(size_t tamanho) {
+        m_tamanho.ajustar(tamanho);
+        m_table_size = m_tamanho.tamanho();
+        m_table.clear();
+        m_table.resize(m_table_size);
     }
 
-    // Adiciona uma chave e um valor à tabela hash. Se a chave já existe, seu valor é atualizado.
-    void add(const KeyType& key, const ValueType& value) {
+    // Busca a chave (aplicando a política de reordenação no acerto) ou a insere com 'value'
+    // no fim da cadeia. Retorna o endereço do valor guardado.
+    ValueType* inserir_ou_localizar(const KeyType& key, const ValueType& value, bool& inserido) {
         // Verifica se o fator de carga atual excede o máximo permitido e faz um rehash se necessário.
         if(load_factor() >= m_max_load_factor)
-            rehash(2 * m_table_size); // Dobra o tamanho da tabela para o rehash.
+            rehash(TamanhoPrimo::crescer(m_table_size)); // Dois degraus da escada: o tamanho dobra.
 
-        size_t slot = hash_code(key); // Calcula o slot (índice do bucket) para a chave.
+        size_t h = m_hashing(key);  // O hash é calculado uma única vez por operação.
+        size_t slot = slot_de(h);   // Calcula o slot (índice do bucket) para a chave.
+        auto& lista = m_table[slot];
         // Percorre a lista no slot para verificar se a chave já existe.
-        for(auto& elem : m_table[slot]) {
-            comparacoes_principal++; // Incrementa o contador de comparações.
-            if(elem.key == key) {     // Se a chave for encontrada, atualiza seu valor.
-                elem.value = value;
-                return; // Sai da função, pois a atualização foi feita.
+        for(auto it = lista.begin(); it != lista.end(); ++it) {
+            m_stats.comparacao(); // Incrementa o contador de comparações.
+            if(it->hash == h && it->key == key) { // Chave encontrada.
+                Reordenacao::acerto(lista, it); // Aproxima a chave do início da lista (conforme a política).
+                inserido = false;
+                return &it->value;
             }
         }
         // Se a chave não foi encontrada, adiciona um novo elemento ao final da lista no slot.
-        m_table[slot].push_back(Elemento(key, value));
+        lista.push_back(Elemento(key, value, h));
         m_number_of_elements++; // Incrementa o número de elementos únicos.
+        inserido = true;
+        return &lista.back().value;
     }
 
+public:
+    // Construtor da tabela hash.
+    // Inicializa o tamanho da tabela com um primo da escada e define o fator de carga máximo.
+    ChainedHashTable(size_t tableSize = 19, float load_factor = 1.0) {
+        alocar(tableSize); // Define o tamanho da tabela para o próximo primo da escada.
+        // Garante que o fator de carga seja um valor positivo.
+        m_max_load_factor = (load_factor <= 0) ? 1.0f : load_factor;
+    }
+
+    // Adiciona uma chave e um valor à tabela hash. Se a chave já existe, seu valor é atualizado.
+    void add(const KeyType& key, const ValueType& value) {
+        bool inserido;
+        ValueType* valor = inserir_ou_localizar(key, value, inserido);
+        if(!inserido) *valor = value;
+    }
+
+    // Endereço do valor da chave, inserida com ValueType() se ainda não existir.
+    // Os nós das listas não mudam de endereço (o rehash e a reordenação só religam nós),
+    // então o ponteiro vale até a chave ser removida.
+    ValueType* find_or_insert(const KeyType& key) {
+        bool inserido;
+        return inserir_ou_localizar(key, ValueType(), inserido);
+    }
+
+    // Muda a cada remoção: ponteiros obtidos com find_or_insert antes disso podem não valer mais.
+    size_t versao() const { return m_versao; }
+
     // Verifica se uma chave está presente na tabela hash.
     bool contains(const KeyType& key) const {
-        size_t slot = hash_code(key); // Calcula o slot da chave.
-        // Percorre a lista no slot para verificar a presença do elemento.
-        for(const auto& elem : m_table[slot]) {
-            if(elem.key == key) return true; // Se encontrado, retorna true.
+        size_t h = m_hashing(key);
+        // Percorre a lista no slot da chave para verificar a presença do elemento.
+        for(const auto& elem : m_table[slot_de(h)]) {
+            if(elem.hash == h && elem.key == key) return true; // Se encontrado, retorna true.
         }
         return false; // Se não encontrado após percorrer a lista, retorna false.
     }
@@ -102,23 +163,28 @@ public:
     // Retorna o valor associado a uma chave específica.
     // Retorna um valor padrão (ValueType()) se a chave não for encontrada.
     ValueType count(const KeyType& key) const {
-        size_t slot = hash_code(key); // Calcula o slot da chave.
-        // Percorre a lista no slot para encontrar o elemento.
-        for(const auto& elem : m_table[slot]) {
-            if(elem.key == key) return elem.value; // Se encontrado, retorna seu valor.
+        size_t h = m_hashing(key);
+        // Percorre a lista no slot da chave para encontrar o elemento.
+        for(const auto& elem : m_table[slot_de(h)]) {
+            if(elem.hash == h && elem.key == key) return elem.value; // Se encontrado, retorna seu valor.
         }
         return ValueType(); // Se não encontrado, retorna um valor padrão para ValueType (ex: 0 para int, string vazia para string).
     }
 
     // Remove uma chave da tabela hash.
     void remove(const KeyType& key) {
-        size_t slot = hash_code(key);
+        size_t h = m_hashing(key);
+        size_t slot = slot_de(h);
         // Itera pela lista para encontrar e remover o elemento.
         // Usa `std::list::erase` com o iterador.
         for(auto it = m_table[slot].begin(); it != m_table[slot].end(); ++it) {
-            if(it->key == key) {
+            if(it->hash == h && it->key == key) {
                 m_table[slot].erase(it);
                 m_number_of_elements--;
+                ++m_versao;
+                if(m_table_size > TamanhoPrimo::proximo(TAMANHO_MINIMO) &&
+                   load_factor() < FRACAO_ENCOLHIMENTO * m_max_load_factor)
+                    rehash(static_cast<size_t>(2 * m_number_of_elements / m_max_load_factor));
                 return;
             }
         }
@@ -126,24 +192,44 @@ public:
 
     // Realiza uma operação de rehash, redimensionando a tabela para um novo tamanho.
     // Isso é feito para manter o fator de carga abaixo do limite, melhorando o desempenho.
+    // O tamanho pode diminuir, mas nunca abaixo do necessário para os elementos atuais
+    // respeitarem o fator de carga máximo (nem abaixo do tamanho padrão).
     void rehash(size_t new_size) {
-        size_t prime = get_next_prime(new_size); // Obtém o próximo número primo para o novo tamanho.
-        if(prime > m_table_size) { // Só faz rehash se o novo tamanho for maior que o atual.
-            contador_rehash++; // Incrementa o contador de rehash.
+        new_size = std::max({new_size, minimo_para(m_number_of_elements), TAMANHO_MINIMO});
+        size_t prime = TamanhoPrimo::proximo(new_size); // Obtém o próximo primo da escada para o novo tamanho.
+        if(prime != m_table_size) { // Só faz rehash se o tamanho mudar.
+            m_stats.reestruturacao(); // Incrementa o contador de rehash.
             std::vector<std::list<Elemento>> old_table = std::move(m_table); // Move para evitar cópia desnecessária.
-            m_table.clear();                                      // Limpa a tabela atual.
-            m_table.resize(prime);                                // Redimensiona a tabela para o novo tamanho primo.
-            m_table_size = prime;                                 // Atualiza o tamanho da tabela.
-            m_number_of_elements = 0;                             // Reseta o número de elementos (serão reinseridos).
-            // Percorre todos os elementos da tabela antiga e os readiciona à nova tabela.
+            alocar(prime);
+            // Move os nós da tabela antiga para os novos buckets usando o hash guardado:
+            // as chaves são distintas, então não há busca nem realocação.
             for(auto& bucket : old_table) {
-                for(auto& elem : bucket) {
-                    add(elem.key, elem.value); // Readiciona cada elemento com sua chave e valor.
+                while(!bucket.empty()) {
+                    auto& destino = m_table[slot_de(bucket.front().hash)];
+                    destino.splice(destino.end(), bucket, bucket.begin());
                 }
             }
         }
     }
 
+    // Garante espaço para 'n' elementos sem rehash durante as inserções.
+    // Com a tabela vazia só realoca os buckets (não há o que reinserir, então não conta como rehash).
+    void reserve(size_t n) {
+        size_t necessario = minimo_para(n);
+        if(necessario <= m_table_size) return;
+        if(m_number_of_elements == 0) {
+            alocar(necessario);
+        } else {
+            rehash(necessario);
+        }
+    }
+
+    // Reduz a tabela ao menor primo da escada que comporta os elementos atuais,
+    // devolvendo a memória dos buckets que sobraram (ex.: depois de remover palavras raras).
+    void shrink_to_fit() {
+        rehash(minimo_para(m_number_of_elements));
+    }
+
     // Coleta todos os pares (chave, valor) da tabela hash em um vetor.
     void getAllPairs(std::vector<std::pair<KeyType, ValueType>>& out) const {
         out.clear(); // Limpa o vetor de saída.
@@ -163,16 +249,35 @@ public:
     }
 
     // Retorna o número total de comparações de chaves realizadas durante as operações de adição.
-    long long getComparacoesPrincipal() const { return comparacoes_principal; }
+    long long getComparacoesPrincipal() const { return m_stats.comparacoes(); }
     // Retorna o número de vezes que a tabela foi rehashada.
-    long long getContadorRehash() const { return contador_rehash; }
+    long long getContadorRehash() const { return m_stats.reestruturacoes(); }
 
     // Métodos para resetar os contadores.
-    void resetComparacoes() { comparacoes_principal = 0; }
-    void resetRehash() { contador_rehash = 0; }
+    void resetComparacoes() { m_stats.resetComparacoes(); }
+    void resetRehash() { m_stats.resetReestruturacoes(); }
 
     // Retorna o número de elementos únicos.
     size_t size() const { return m_number_of_elements; }
+    // Retorna o número de buckets da tabela.
+    size_t bucket_count() const { return m_table_size; }
+
+    // Calcula os histogramas de comprimento de cadeia e de sondagem percorrendo a tabela.
+    // Uma chave na posição i da sua lista custa i + 1 comparações; uma busca sem sucesso
+    // compara com todos os elementos do bucket.
+    EstatisticasHash estatisticas() const {
+        EstatisticasHash e;
+        e.buckets = m_table_size;
+        e.elementos = m_number_of_elements;
+        for(const auto& bucket : m_table) {
+            size_t comprimento = bucket.size();
+            EstatisticasHash::registrar(e.comprimento_cadeia, comprimento);
+            EstatisticasHash::registrar(e.sondagem_falha, comprimento);
+            for(size_t i = 1; i <= comprimento; ++i)
+                EstatisticasHash::registrar(e.sondagem_sucesso, i);
+        }
+        return e;
+    }
 
     void show() const {
     std::cout << "ChainedHashTable (" << m_number_of_elements << " elementos, "
@@ -0,0 +1,178 @@
+#ifndef ARQUIVO_TOKENS_HPP
+#define ARQUIVO_TOKENS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "buffer_tokens.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Arquivo binário de tokens já normalizados, para repetir medições sobre o mesmo corpus sem
+// pagar de novo a leitura e a normalização ICU (gerado com --dump-tokens, lido com --tokens).
+// Formato:
+//   8 bytes  "FREQTOK1"
+//   8 bytes  número de tokens (uint64 little-endian)
+//   resto    os tokens no formato do BufferTokens (tamanho LEB128 seguido dos bytes)
+
+constexpr char MAGICO_TOKENS[8] = {'F', 'R', 'E', 'Q', 'T', 'O', 'K', '1'};
+constexpr size_t CABECALHO_TOKENS = 16;
+
+// Grava os tokens em blocos: a memória usada não depende do tamanho do corpus.
+// Os tokens vão para '<caminho>.tmp', que só substitui 'caminho' em fechar(): uma gravação
+// interrompida (descartar(), erro de leitura da entrada) não deixa um arquivo válido pela metade
+// nem apaga o arquivo de uma execução anterior.
+class GravadorTokens {
+public:
+    static constexpr size_t TAMANHO_BLOCO = 1 << 20; // Bytes acumulados antes de cada escrita
+
+    explicit GravadorTokens(const std::string& caminho)
+        : m_caminho(caminho), m_temporario(caminho + ".tmp"), m_saida(m_temporario, std::ios::binary | std::ios::trunc) {
+        if (!m_saida.is_open()) return;
+        m_saida.write(MAGICO_TOKENS, sizeof(MAGICO_TOKENS));
+        escreverContagem(); // Provisório; corrigido em fechar()
+    }
+
+    bool aberto() const { return m_saida.is_open(); }
+
+    void adicionar(const std::string& token) {
+        m_buffer.adicionar(token);
+        m_total++;
+        if (m_buffer.bytes() >= TAMANHO_BLOCO) descarregar();
+    }
+
+    // Grava o que falta e o número final de tokens e move o temporário para o caminho final.
+    // Retorna false (sem tocar no caminho final) se alguma escrita falhou.
+    bool fechar() {
+        descarregar();
+        m_saida.seekp(sizeof(MAGICO_TOKENS));
+        escreverContagem();
+        m_saida.close();
+        if (m_saida.fail() || std::rename(m_temporario.c_str(), m_caminho.c_str()) != 0) {
+            std::remove(m_temporario.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Abandona a gravação: apaga o temporário e mantém o caminho final como estava.
+    void descartar() {
+        m_saida.close();
+        std::remove(m_temporario.c_str());
+    }
+
+    uint64_t tokens() const { return m_total; }
+    uint64_t bytes() const { return CABECALHO_TOKENS + m_gravados + m_buffer.bytes(); }
+
+private:
+    std::string m_caminho;
+    std::string m_temporario;
+    std::ofstream m_saida;
+    BufferTokens m_buffer;
+    uint64_t m_total = 0;
+    uint64_t m_gravados = 0; // Bytes de tokens já escritos (sem o cabeçalho)
+
+    void descarregar() {
+        m_saida.write(m_buffer.dados().data(), static_cast<std::streamsize>(m_buffer.bytes()));
+        m_gravados += m_buffer.bytes();
+        m_buffer.limpar();
+    }
+
+    void escreverContagem() {
+        unsigned char bytes[8];
+        for (int i = 0; i < 8; ++i) bytes[i] = static_cast<unsigned char>(m_total >> (8 * i));
+        m_saida.write(reinterpret_cast<const char*>(bytes), 8);
+    }
+};
+
+// Abre um arquivo de tokens para leitura. Em sistemas POSIX ele é mapeado na memória (mmap,
+// acesso sequencial) e percorrido sem cópia; nos demais é lido inteiro para a memória.
+class ArquivoTokens {
+public:
+    explicit ArquivoTokens(const std::string& caminho) {
+#if defined(__unix__) || defined(__APPLE__)
+        int descritor = ::open(caminho.c_str(), O_RDONLY);
+        if (descritor < 0) {
+            m_erro = "não foi possível abrir";
+            return;
+        }
+        struct stat info;
+        if (::fstat(descritor, &info) == 0 && info.st_size >= static_cast<off_t>(CABECALHO_TOKENS)) {
+            void* mapa = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descritor, 0);
+            if (mapa != MAP_FAILED) {
+                m_dados = static_cast<const char*>(mapa);
+                m_tamanho = static_cast<size_t>(info.st_size);
+                ::madvise(mapa, m_tamanho, MADV_SEQUENTIAL);
+            }
+        }
+        ::close(descritor);
+#else
+        std::ifstream arquivo(caminho, std::ios::binary);
+        if (!arquivo.is_open()) {
+            m_erro = "não foi possível abrir";
+            return;
+        }
+        m_copia.assign(std::istreambuf_iterator<char>(arquivo), std::istreambuf_iterator<char>());
+        m_dados = m_copia.data();
+        m_tamanho = m_copia.size();
+#endif
+        if (m_tamanho < CABECALHO_TOKENS || std::memcmp(m_dados, MAGICO_TOKENS, sizeof(MAGICO_TOKENS)) != 0) {
+            m_erro = "não é um arquivo de tokens (gere com --dump-tokens)";
+            return;
+        }
+        for (int i = 0; i < 8; ++i)
+            m_tokens |= static_cast<uint64_t>(static_cast<unsigned char>(m_dados[8 + i])) << (8 * i);
+    }
+
+    ArquivoTokens(const ArquivoTokens&) = delete;
+    ArquivoTokens& operator=(const ArquivoTokens&) = delete;
+
+    ~ArquivoTokens() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (m_dados) ::munmap(const_cast<char*>(m_dados), m_tamanho);
+#endif
+    }
+
+    bool aberto() const { return m_erro.empty(); }
+    const std::string& erro() const { return m_erro; }
+    uint64_t tokens() const { return m_tokens; }
+    size_t bytes() const { return m_tamanho; }
+
+    // Chama 'processar(const std::string&)' para cada token. Retorna false (com erro()) se o
+    // arquivo estiver truncado ou não tiver o número de tokens do cabeçalho.
+    template <typename Funcao>
+    bool percorrer(Funcao&& processar) {
+        uint64_t lidos = 0;
+        bool completo = percorrer_tokens_codificados(m_dados + CABECALHO_TOKENS, m_dados + m_tamanho,
+                                                     [&](const std::string& token) {
+                                                         lidos++;
+                                                         processar(token);
+                                                     });
+        if (!completo || lidos != m_tokens) {
+            m_erro = "arquivo de tokens truncado ou corrompido";
+            return false;
+        }
+        return true;
+    }
+
+private:
+    const char* m_dados = nullptr;
+    size_t m_tamanho = 0;
+    uint64_t m_tokens = 0;
+    std::string m_erro;
+#if !(defined(__unix__) || defined(__APPLE__))
+    std::string m_copia;
+#endif
+};
+
+#endif // ARQUIVO_TOKENS_HPP
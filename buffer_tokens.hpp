@@ -0,0 +1,70 @@
+#ifndef BUFFER_TOKENS_HPP
+#define BUFFER_TOKENS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Sequência de tokens já normalizados guardada num único bloco de bytes, para ser percorrida
+// várias vezes sem repetir a leitura do arquivo e a normalização ICU (modo 'all' do main_final).
+// É também o corpo dos arquivos de tokens de --dump-tokens/--tokens (ver arquivo_tokens.hpp).
+// Cada token é gravado como o seu tamanho (inteiro sem sinal em base 128, LEB128: 1 byte para
+// tokens de até 127 bytes) seguido dos bytes do token, sem separadores.
+
+// Percorre os tokens codificados em [inicio, fim), chamando 'processar(const std::string&)' para
+// cada um. Retorna false se os dados terminarem no meio de um token (buffer truncado).
+template <typename Funcao>
+bool percorrer_tokens_codificados(const char* inicio, const char* fim, Funcao&& processar) {
+    std::string palavra; // Reaproveitado: só realoca quando aparece um token maior
+    while (inicio < fim) {
+        uint64_t tamanho = 0;
+        int deslocamento = 0;
+        unsigned char byte;
+        do {
+            if (inicio == fim || deslocamento > 63) return false;
+            byte = static_cast<unsigned char>(*inicio++);
+            tamanho |= static_cast<uint64_t>(byte & 0x7F) << deslocamento;
+            deslocamento += 7;
+        } while (byte & 0x80);
+        if (tamanho > static_cast<uint64_t>(fim - inicio)) return false;
+        palavra.assign(inicio, static_cast<size_t>(tamanho));
+        inicio += tamanho;
+        processar(palavra);
+    }
+    return true;
+}
+
+class BufferTokens {
+public:
+    void adicionar(const std::string& token) {
+        uint64_t tamanho = token.size();
+        while (tamanho >= 0x80) {
+            m_dados.push_back(static_cast<char>((tamanho & 0x7F) | 0x80));
+            tamanho >>= 7;
+        }
+        m_dados.push_back(static_cast<char>(tamanho));
+        m_dados.append(token);
+        m_tokens++;
+    }
+
+    template <typename Funcao>
+    void percorrer(Funcao&& processar) const {
+        percorrer_tokens_codificados(m_dados.data(), m_dados.data() + m_dados.size(), processar);
+    }
+
+    // Esvazia o buffer (mantém a memória reservada).
+    void limpar() {
+        m_dados.clear();
+        m_tokens = 0;
+    }
+
+    size_t tokens() const { return m_tokens; }
+    size_t bytes() const { return m_dados.size(); }
+    const std::string& dados() const { return m_dados; }
+
+private:
+    std::string m_dados;
+    size_t m_tokens = 0;
+};
+
+#endif // BUFFER_TOKENS_HPP
@@ -0,0 +1,113 @@
+#ifndef CACHE_RECENTE_HPP
+#define CACHE_RECENTE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+// Cache pequeno, associativo por conjunto de 2 vias, na frente de um dicionário de contagem.
+// Texto natural repete as mesmas poucas centenas de palavras o tempo todo: para elas o cache
+// guarda a posição do contador (nó da árvore, nó da lista ou valor do slot) e um acerto só
+// incrementa o contador, sem descida na árvore nem sondagem na tabela.
+// - Indexado pelo hash do token; cada entrada guarda o hash e a chave para confirmar o acerto.
+// - Em cada conjunto, a via substituída numa falta é a menos recentemente usada.
+// - Numa falta o dicionário faz o trabalho normal (localizar_ou_inserir), então os contadores
+//   de comparações do dicionário passam a medir só as faltas.
+//
+// 'Dicionario' precisa oferecer (DicionarioAvl, DicionarioRb, DicionarioChained, DicionarioOpen):
+//   Posicao                              posição estável do contador de uma chave;
+//   Posicao localizar_ou_inserir(chave)  encontra ou insere a chave com contador zero;
+//   void incrementar(Posicao)            soma 1 ao contador;
+//   size_t versao() const                muda quando posições antigas deixam de valer (rehash
+//                                        do endereçamento aberto, remoções, clear); o cache
+//                                        então se esvazia sozinho antes de usar qualquer posição.
+template <typename Dicionario, typename Key, typename Hash = std::hash<Key>>
+class CacheRecente {
+public:
+    using Posicao = typename Dicionario::Posicao;
+
+    // 'entradas' é arredondado para uma potência de dois (mínimo 2, um conjunto de 2 vias).
+    CacheRecente(Dicionario& dicionario, size_t entradas)
+        : m_dicionario(dicionario), m_versao(dicionario.versao()) {
+        size_t conjuntos = 1;
+        while (conjuntos * 2 < entradas) conjuntos <<= 1;
+        m_mascara = conjuntos - 1;
+        m_entradas.resize(conjuntos * 2);
+        m_proxima_via.assign(conjuntos, 0);
+    }
+
+    // Conta mais uma ocorrência de 'chave'.
+    void incrementar(const Key& chave) {
+        if (m_dicionario.versao() != m_versao) { // Remoção feita direto no dicionário desde a última chamada
+            invalidar();
+            m_versao = m_dicionario.versao();
+        }
+        size_t h = m_hashing(chave);
+        size_t conjunto = h & m_mascara;
+        Entrada* vias = &m_entradas[conjunto * 2];
+        for (int via = 0; via < 2; ++via) {
+            Entrada& entrada = vias[via];
+            if (entrada.valida && entrada.hash == h && entrada.chave == chave) {
+                m_dicionario.incrementar(entrada.posicao);
+                m_proxima_via[conjunto] = static_cast<uint8_t>(1 - via); // A outra via vira a menos recente
+                ++m_acertos;
+                return;
+            }
+        }
+
+        ++m_faltas;
+        Posicao posicao = m_dicionario.localizar_ou_inserir(chave);
+        m_dicionario.incrementar(posicao);
+        if (m_dicionario.versao() != m_versao) { // A inserção realocou o dicionário
+            invalidar();
+            m_versao = m_dicionario.versao();
+        }
+        int via = m_proxima_via[conjunto];
+        vias[via].valida = true;
+        vias[via].hash = h;
+        vias[via].chave = chave;
+        vias[via].posicao = posicao;
+        m_proxima_via[conjunto] = static_cast<uint8_t>(1 - via);
+    }
+
+    // Esquece todas as posições guardadas.
+    void invalidar() {
+        for (auto& entrada : m_entradas) entrada.valida = false;
+    }
+
+    size_t entradas() const { return m_entradas.size(); }
+    long long acertos() const { return m_acertos; }
+    long long faltas() const { return m_faltas; }
+    double taxa_acerto() const {
+        long long total = m_acertos + m_faltas;
+        return total ? static_cast<double>(m_acertos) / total : 0.0;
+    }
+
+    void escrever(std::ostream& saida) const {
+        saida << "cache de tokens recentes (" << entradas() << " entradas, 2 vias): "
+              << m_acertos << " acertos, " << m_faltas << " faltas, taxa de acerto "
+              << std::fixed << std::setprecision(2) << taxa_acerto() * 100.0 << "%\n";
+    }
+
+private:
+    struct Entrada {
+        bool valida = false;
+        size_t hash = 0;
+        Key chave{};
+        Posicao posicao{};
+    };
+
+    Dicionario& m_dicionario;
+    std::vector<Entrada> m_entradas;       // Conjunto c ocupa as posições 2c e 2c + 1
+    std::vector<uint8_t> m_proxima_via;    // Via a substituir na próxima falta de cada conjunto
+    size_t m_mascara = 0;
+    size_t m_versao;
+    Hash m_hashing;
+    long long m_acertos = 0;
+    long long m_faltas = 0;
+};
+
+#endif // CACHE_RECENTE_HPP
@@ -0,0 +1,102 @@
+#ifndef CANDIDATOS_TOP_K_HPP
+#define CANDIDATOS_TOP_K_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "ChainedHashTable.hpp" // Índice chave -> posição no heap
+
+// Os K candidatos de maior estimativa do modo 'cms', num heap de mínimo indexado.
+// - O menor candidato fica na raiz: decidir se uma chave nova entra custa O(1) e a troca, O(log K).
+// - O índice guarda a posição de cada chave no heap (+ 1, para 0 significar "ausente"), então
+//   atualizar um candidato também custa O(log K), sem percorrer os K pares.
+// Diferente do stream-summary do SpaceSaving, as estimativas podem saltar de vários em vários
+// (vêm do sketch), por isso a ordem é mantida por um heap e não por baldes de contagem + 1.
+template <typename Key, typename Hash = std::hash<Key>>
+class CandidatosTopK {
+private:
+    struct Entrada {
+        Key chave;
+        uint32_t estimativa;
+        size_t* posicao; // Valor da chave no índice: estável até a chave ser removida
+    };
+
+    size_t m_capacidade;
+    std::vector<Entrada> m_heap; // m_heap[0] é o candidato de menor estimativa
+    ChainedHashTable<Key, size_t, Hash, OrdemInsercao, NullStats> m_indice; // Comparações não são reportadas
+
+    void colocar(size_t i, Entrada&& entrada) {
+        m_heap[i] = std::move(entrada);
+        *m_heap[i].posicao = i + 1;
+    }
+
+    void subir(size_t i) {
+        Entrada entrada = std::move(m_heap[i]);
+        while (i > 0) {
+            size_t pai = (i - 1) / 2;
+            if (m_heap[pai].estimativa <= entrada.estimativa) break;
+            colocar(i, std::move(m_heap[pai]));
+            i = pai;
+        }
+        colocar(i, std::move(entrada));
+    }
+
+    void descer(size_t i) {
+        Entrada entrada = std::move(m_heap[i]);
+        size_t n = m_heap.size();
+        while (2 * i + 1 < n) {
+            size_t filho = 2 * i + 1;
+            if (filho + 1 < n && m_heap[filho + 1].estimativa < m_heap[filho].estimativa) ++filho;
+            if (entrada.estimativa <= m_heap[filho].estimativa) break;
+            colocar(i, std::move(m_heap[filho]));
+            i = filho;
+        }
+        colocar(i, std::move(entrada));
+    }
+
+public:
+    explicit CandidatosTopK(size_t k) : m_capacidade(k), m_indice(k + 1) { m_heap.reserve(k); }
+
+    CandidatosTopK(const CandidatosTopK&) = delete;
+    CandidatosTopK& operator=(const CandidatosTopK&) = delete;
+
+    // Registra a estimativa atual de 'chave'. Um candidato é só reposicionado; uma chave nova
+    // entra se houver vaga ou se superar o menor candidato, que então sai.
+    void atualizar(const Key& chave, uint32_t estimativa) {
+        size_t posicao = m_indice.count(chave);
+        if (posicao != 0) {
+            size_t i = posicao - 1;
+            uint32_t anterior = m_heap[i].estimativa;
+            m_heap[i].estimativa = estimativa;
+            if (estimativa < anterior) subir(i);
+            else descer(i);
+            return;
+        }
+        if (m_heap.size() < m_capacidade) {
+            m_heap.push_back(Entrada{chave, estimativa, m_indice.find_or_insert(chave)});
+            subir(m_heap.size() - 1);
+            return;
+        }
+        if (m_capacidade == 0 || estimativa <= m_heap[0].estimativa) return;
+        m_indice.remove(m_heap[0].chave);
+        colocar(0, Entrada{chave, estimativa, m_indice.find_or_insert(chave)});
+        descer(0);
+    }
+
+    size_t size() const { return m_heap.size(); }
+    size_t capacidade() const { return m_capacidade; }
+    // Menor estimativa entre os candidatos (0 se ainda não há nenhum).
+    uint32_t minimo() const { return m_heap.empty() ? 0 : m_heap[0].estimativa; }
+
+    // Pares (chave, estimativa) de todos os candidatos, sem ordem definida.
+    void getAllPairs(std::vector<std::pair<Key, uint32_t>>& out) const {
+        out.clear();
+        out.reserve(m_heap.size());
+        for (const Entrada& entrada : m_heap) out.emplace_back(entrada.chave, entrada.estimativa);
+    }
+};
+
+#endif // CANDIDATOS_TOP_K_HPP
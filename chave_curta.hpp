@@ -0,0 +1,183 @@
+#ifndef CHAVE_CURTA_HPP
+#define CHAVE_CURTA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// Chave de texto de tamanho fixo (32 bytes, o mesmo de um std::string) que guarda palavras
+// de até 24 bytes dentro do próprio objeto, sem alocação.
+// - Curta (até 24 bytes): os bytes ficam em três palavras de 64 bits completadas com zeros.
+//   Igualdade são 3 comparações de inteiros; a ordem compara as palavras lidas em big-endian,
+//   o que dá a mesma ordem lexicográfica de std::string (bytes sem sinal, prefixo antes).
+// - Longa: as duas primeiras palavras guardam os 16 primeiros bytes (a maioria das comparações
+//   se resolve nelas) e a terceira é um ponteiro para a cópia completa no heap.
+// Pode ser usada como Key em Set, rbtree, ChainedHashTable, HashAberto, HashRobinHood e
+// HashCuckoo (operadores <, == e std::hash<ChaveCurta> definidos abaixo).
+class ChaveCurta {
+public:
+    static constexpr size_t CAPACIDADE_INTERNA = 24;
+
+    ChaveCurta() : m_palavras{0, 0, 0}, m_tamanho(0) {}
+
+    ChaveCurta(const char* dados, size_t tamanho) : m_palavras{0, 0, 0}, m_tamanho(static_cast<uint32_t>(tamanho)) {
+        if (tamanho <= CAPACIDADE_INTERNA) {
+            std::memcpy(m_palavras, dados, tamanho);
+        } else {
+            std::memcpy(m_palavras, dados, 16);
+            char* copia = new char[tamanho];
+            std::memcpy(copia, dados, tamanho);
+            definirExterno(copia);
+        }
+    }
+
+    // Conversões implícitas: permitem passar as palavras lidas (std::string) direto aos dicionários.
+    ChaveCurta(std::string_view texto) : ChaveCurta(texto.data(), texto.size()) {}
+    ChaveCurta(const std::string& texto) : ChaveCurta(texto.data(), texto.size()) {}
+    ChaveCurta(const char* texto) : ChaveCurta(texto, std::strlen(texto)) {}
+
+    ChaveCurta(const ChaveCurta& outra)
+        : m_palavras{outra.m_palavras[0], outra.m_palavras[1], outra.m_palavras[2]}, m_tamanho(outra.m_tamanho) {
+        if (outra.ehLonga()) {
+            char* copia = new char[m_tamanho];
+            std::memcpy(copia, outra.externo(), m_tamanho);
+            definirExterno(copia);
+        }
+    }
+
+    ChaveCurta(ChaveCurta&& outra) noexcept
+        : m_palavras{outra.m_palavras[0], outra.m_palavras[1], outra.m_palavras[2]}, m_tamanho(outra.m_tamanho) {
+        outra.zerar(); // A longa passa o ponteiro adiante
+    }
+
+    ChaveCurta& operator=(const ChaveCurta& outra) {
+        if (this != &outra) {
+            ChaveCurta copia(outra);
+            *this = std::move(copia);
+        }
+        return *this;
+    }
+
+    ChaveCurta& operator=(ChaveCurta&& outra) noexcept {
+        if (this != &outra) {
+            liberar();
+            std::memcpy(m_palavras, outra.m_palavras, sizeof(m_palavras));
+            m_tamanho = outra.m_tamanho;
+            outra.zerar();
+        }
+        return *this;
+    }
+
+    ~ChaveCurta() { liberar(); }
+
+    size_t size() const { return m_tamanho; }
+    bool empty() const { return m_tamanho == 0; }
+    bool ehLonga() const { return m_tamanho > CAPACIDADE_INTERNA; }
+    const char* data() const { return ehLonga() ? externo() : reinterpret_cast<const char*>(m_palavras); }
+    std::string_view view() const { return std::string_view(data(), m_tamanho); }
+    std::string str() const { return std::string(data(), m_tamanho); }
+
+    // < 0, 0 ou > 0, como std::string::compare.
+    int comparar(const ChaveCurta& outra) const {
+        // Os 16 primeiros bytes estão em m_palavras nos dois formatos.
+        for (int i = 0; i < 2; ++i)
+            if (m_palavras[i] != outra.m_palavras[i])
+                return bigEndian(m_palavras[i]) < bigEndian(outra.m_palavras[i]) ? -1 : 1;
+        if (!ehLonga() && !outra.ehLonga()) {
+            if (m_palavras[2] != outra.m_palavras[2])
+                return bigEndian(m_palavras[2]) < bigEndian(outra.m_palavras[2]) ? -1 : 1;
+        } else {
+            // Pelo menos uma é longa: os bytes [0, 16) são iguais; compara o restante.
+            size_t menor = std::min(m_tamanho, outra.m_tamanho);
+            if (menor > 16) {
+                int c = std::memcmp(data() + 16, outra.data() + 16, menor - 16);
+                if (c != 0) return c;
+            }
+        }
+        // Bytes iguais até o fim da menor: a mais curta vem antes.
+        return (m_tamanho < outra.m_tamanho) ? -1 : (m_tamanho > outra.m_tamanho);
+    }
+
+    bool operator==(const ChaveCurta& outra) const {
+        if (m_tamanho != outra.m_tamanho || m_palavras[0] != outra.m_palavras[0] ||
+            m_palavras[1] != outra.m_palavras[1])
+            return false;
+        if (!ehLonga()) return m_palavras[2] == outra.m_palavras[2];
+        return std::memcmp(externo() + 16, outra.externo() + 16, m_tamanho - 16) == 0;
+    }
+    bool operator!=(const ChaveCurta& outra) const { return !(*this == outra); }
+    bool operator<(const ChaveCurta& outra) const { return comparar(outra) < 0; }
+    bool operator>(const ChaveCurta& outra) const { return comparar(outra) > 0; }
+    bool operator<=(const ChaveCurta& outra) const { return comparar(outra) <= 0; }
+    bool operator>=(const ChaveCurta& outra) const { return comparar(outra) >= 0; }
+
+    // Hash: nas curtas, mistura as três palavras e o tamanho sem percorrer bytes.
+    size_t hash() const {
+        if (ehLonga()) return std::hash<std::string_view>()(view());
+        uint64_t h = misturar(m_tamanho ^ 0x9E3779B97F4A7C15ULL);
+        h = misturar(h ^ m_palavras[0]);
+        h = misturar(h ^ m_palavras[1]);
+        return static_cast<size_t>(misturar(h ^ m_palavras[2]));
+    }
+
+    // Respeita std::setw e std::left como um std::string.
+    friend std::ostream& operator<<(std::ostream& saida, const ChaveCurta& chave) {
+        return saida << chave.view();
+    }
+
+private:
+    // Curta: os bytes da chave, completados com zeros.
+    // Longa: [0] e [1] com os 16 primeiros bytes, [2] com o ponteiro para a cópia completa.
+    uint64_t m_palavras[3];
+    uint32_t m_tamanho;
+
+    char* externo() const {
+        char* ponteiro;
+        std::memcpy(&ponteiro, &m_palavras[2], sizeof(ponteiro));
+        return ponteiro;
+    }
+
+    void definirExterno(char* ponteiro) {
+        static_assert(sizeof(char*) <= sizeof(uint64_t), "ponteiro não cabe em 64 bits");
+        m_palavras[2] = 0;
+        std::memcpy(&m_palavras[2], &ponteiro, sizeof(ponteiro));
+    }
+
+    void liberar() {
+        if (ehLonga()) delete[] externo();
+    }
+
+    void zerar() {
+        m_palavras[0] = m_palavras[1] = m_palavras[2] = 0;
+        m_tamanho = 0;
+    }
+
+    static uint64_t bigEndian(uint64_t palavra) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        return __builtin_bswap64(palavra);
+#else
+        return palavra;
+#endif
+    }
+
+    // Finalizador do splitmix64.
+    static uint64_t misturar(uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+};
+
+namespace std {
+template <>
+struct hash<ChaveCurta> {
+    size_t operator()(const ChaveCurta& chave) const { return chave.hash(); }
+};
+} // namespace std
+
+#endif // CHAVE_CURTA_HPP
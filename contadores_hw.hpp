@@ -0,0 +1,154 @@
+#ifndef CONTADORES_HW_HPP
+#define CONTADORES_HW_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Contadores de desempenho do processador (via perf_event_open no Linux) para medir uma fase
+// do programa: ciclos, instruções, falhas de cache L1d e LLC, falhas de dTLB e desvios mal previstos.
+// Cada evento é aberto separadamente, então um evento não suportado não derruba os demais.
+// Quando o kernel não permite a medição (perf_event_paranoid, contêineres, VMs) ou o sistema
+// não é Linux, os eventos ficam marcados como indisponíveis e nada mais muda no programa.
+class ContadoresHardware {
+public:
+    enum Evento { CICLOS, INSTRUCOES, FALHAS_L1D, FALHAS_LLC, FALHAS_DTLB, DESVIOS_ERRADOS, NUM_EVENTOS };
+
+private:
+    bool m_ativo;
+    int m_fds[NUM_EVENTOS];
+    uint64_t m_valores[NUM_EVENTOS] = {};
+    std::string m_erro; // Motivo da primeira falha ao abrir um evento
+
+#if defined(__linux__)
+    static int abrirEvento(uint32_t tipo, uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = tipo;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // Tempo habilitado/em execução permite corrigir a multiplexação de contadores.
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    static uint64_t configCache(uint64_t cache, uint64_t operacao, uint64_t resultado) {
+        return cache | (operacao << 8) | (resultado << 16);
+    }
+#endif
+
+public:
+    // Com 'ativo' = false nenhum evento é aberto (custo zero quando a opção não é pedida).
+    explicit ContadoresHardware(bool ativo) : m_ativo(ativo) {
+        for (int i = 0; i < NUM_EVENTOS; ++i) m_fds[i] = -1;
+        if (!m_ativo) return;
+#if defined(__linux__)
+        const uint32_t tipos[NUM_EVENTOS] = {
+            PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+            PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE};
+        const uint64_t configs[NUM_EVENTOS] = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            configCache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS),
+            configCache(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS),
+            configCache(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS),
+            PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < NUM_EVENTOS; ++i) {
+            m_fds[i] = abrirEvento(tipos[i], configs[i]);
+            if (m_fds[i] < 0 && m_erro.empty()) m_erro = std::strerror(errno);
+        }
+#else
+        m_erro = "perf_event_open disponível apenas no Linux";
+#endif
+    }
+
+    ~ContadoresHardware() {
+#if defined(__linux__)
+        for (int i = 0; i < NUM_EVENTOS; ++i)
+            if (m_fds[i] >= 0) close(m_fds[i]);
+#endif
+    }
+
+    ContadoresHardware(const ContadoresHardware&) = delete;
+    ContadoresHardware& operator=(const ContadoresHardware&) = delete;
+
+    // Zera e liga os contadores disponíveis.
+    void iniciar() {
+#if defined(__linux__)
+        for (int i = 0; i < NUM_EVENTOS; ++i) {
+            if (m_fds[i] < 0) continue;
+            ioctl(m_fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Desliga os contadores e guarda as leituras (escaladas se houve multiplexação).
+    void parar() {
+#if defined(__linux__)
+        for (int i = 0; i < NUM_EVENTOS; ++i) {
+            if (m_fds[i] < 0) continue;
+            ioctl(m_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t leitura[3] = {}; // valor, tempo habilitado, tempo em execução
+            if (read(m_fds[i], leitura, sizeof(leitura)) != static_cast<ssize_t>(sizeof(leitura))) continue;
+            m_valores[i] = (leitura[2] > 0 && leitura[2] < leitura[1])
+                ? static_cast<uint64_t>(static_cast<double>(leitura[0]) * leitura[1] / leitura[2])
+                : leitura[0];
+        }
+#endif
+    }
+
+    bool ativo() const { return m_ativo; }
+    bool disponivel(Evento e) const { return m_fds[e] >= 0; }
+    uint64_t valor(Evento e) const { return m_valores[e]; }
+
+    static const char* nome(Evento e) {
+        switch (e) {
+            case CICLOS:          return "ciclos";
+            case INSTRUCOES:      return "instruções";
+            case FALHAS_L1D:      return "falhas de cache L1d (leitura)";
+            case FALHAS_LLC:      return "falhas de cache LLC (leitura)";
+            case FALHAS_DTLB:     return "falhas de dTLB (leitura)";
+            case DESVIOS_ERRADOS: return "desvios mal previstos";
+            default:              return "?";
+        }
+    }
+
+    // Escreve as leituras no bloco de estatísticas de um arquivo de saída (nada se inativo).
+    void escrever(std::ostream& saida) const {
+        if (!m_ativo) return;
+        bool algum = false;
+        for (int i = 0; i < NUM_EVENTOS; ++i) algum = algum || m_fds[i] >= 0;
+        if (!algum) {
+            saida << "contadores de hardware: indisponíveis (" << m_erro << ")\n";
+            return;
+        }
+        saida << "contadores de hardware (fase de montagem):\n";
+        for (int i = 0; i < NUM_EVENTOS; ++i) {
+            Evento e = static_cast<Evento>(i);
+            saida << "  " << nome(e) << ": ";
+            if (disponivel(e)) saida << valor(e);
+            else saida << "indisponível";
+            saida << "\n";
+        }
+        if (disponivel(CICLOS) && disponivel(INSTRUCOES) && valor(CICLOS) > 0) {
+            saida << "  instruções por ciclo (IPC): " << std::fixed << std::setprecision(3)
+                  << static_cast<double>(valor(INSTRUCOES)) / static_cast<double>(valor(CICLOS)) << "\n";
+        }
+    }
+};
+
+#endif // CONTADORES_HW_HPP
@@ -0,0 +1,137 @@
+#ifndef COUNT_MIN_SKETCH_HPP
+#define COUNT_MIN_SKETCH_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <new>
+#include <string>
+#include <vector>
+
+// Count-Min Sketch: contagem aproximada com memória fixa definida na construção.
+// A estimativa nunca é menor que a frequência real e, com probabilidade >= 1 - δ,
+// excede a real em no máximo εN, onde ε = e / largura, δ = e^-profundidade e N é o total contado.
+// - Atualização conservadora: só os contadores iguais ao mínimo sobem, o que reduz o erro
+//   sem alterar os limites acima.
+// - Layout: uma matriz contígua linha a linha, alocada em fronteira de 64 bytes e com a largura
+//   arredondada para múltiplos de 16 contadores de 32 bits (64 bytes), de modo que cada linha
+//   começa numa fronteira de linha de cache e os laços sobre linhas inteiras (limpeza) vetorizam.
+
+// Alocador para std::vector com blocos alinhados em 'Alinhamento' bytes (operator new alinhado do C++17).
+template <typename T, size_t Alinhamento>
+struct AlocadorAlinhado {
+    using value_type = T;
+    template <typename U>
+    struct rebind {
+        using other = AlocadorAlinhado<U, Alinhamento>;
+    };
+
+    AlocadorAlinhado() = default;
+    template <typename U>
+    AlocadorAlinhado(const AlocadorAlinhado<U, Alinhamento>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alinhamento)));
+    }
+    void deallocate(T* p, size_t) { ::operator delete(p, std::align_val_t(Alinhamento)); }
+
+    template <typename U>
+    bool operator==(const AlocadorAlinhado<U, Alinhamento>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlocadorAlinhado<U, Alinhamento>&) const { return false; }
+};
+
+template <typename Key, typename Hash = std::hash<Key>>
+class CountMinSketch {
+public:
+    static constexpr size_t PROFUNDIDADE_MAXIMA = 32;
+
+private:
+    size_t m_largura;      // Contadores usados por linha
+    size_t m_passo;        // Largura arredondada (distância entre linhas na matriz)
+    size_t m_profundidade; // Número de linhas (funções hash)
+    std::vector<uint32_t, AlocadorAlinhado<uint32_t, 64>> m_contadores; // Linha i começa em i * m_passo
+    uint64_t m_total = 0;  // N: soma de todas as ocorrências adicionadas
+    Hash m_hashing;
+
+    // Mistura final do splitmix64: espalha bem os bits de std::hash antes do hashing duplo.
+    static uint64_t misturar(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    // Calcula a coluna de cada linha a partir de um único hash (Kirsch-Mitzenmacher: h1 + i*h2).
+    void calcularColunas(const Key& key, size_t* colunas) const {
+        uint64_t h = misturar(static_cast<uint64_t>(m_hashing(key)));
+        uint32_t h1 = static_cast<uint32_t>(h);
+        uint32_t h2 = static_cast<uint32_t>(h >> 32) | 1u;
+        for (size_t i = 0; i < m_profundidade; ++i) {
+            uint32_t g = h1 + static_cast<uint32_t>(i) * h2;
+            // Redução por multiplicação (evita a divisão do operador %).
+            size_t coluna = static_cast<size_t>((static_cast<uint64_t>(g) * m_largura) >> 32);
+            colunas[i] = i * m_passo + coluna;
+        }
+    }
+
+public:
+    // Cria um sketch com 'largura' contadores por linha e 'profundidade' linhas.
+    CountMinSketch(size_t largura = 65536, size_t profundidade = 4) {
+        m_largura = std::max<size_t>(largura, 1);
+        m_passo = (m_largura + 15) / 16 * 16;
+        m_profundidade = std::min(std::max<size_t>(profundidade, 1), PROFUNDIDADE_MAXIMA);
+        m_contadores.assign(m_passo * m_profundidade, 0);
+    }
+
+    // Conta uma ocorrência de 'key' (atualização conservadora) e retorna a nova estimativa.
+    uint32_t add(const Key& key) {
+        size_t colunas[PROFUNDIDADE_MAXIMA];
+        calcularColunas(key, colunas);
+
+        uint32_t minimo = std::numeric_limits<uint32_t>::max();
+        for (size_t i = 0; i < m_profundidade; ++i)
+            minimo = std::min(minimo, m_contadores[colunas[i]]);
+        m_total++;
+        if (minimo == std::numeric_limits<uint32_t>::max()) return minimo; // Saturado
+
+        uint32_t novo = minimo + 1;
+        for (size_t i = 0; i < m_profundidade; ++i)
+            m_contadores[colunas[i]] = std::max(m_contadores[colunas[i]], novo);
+        return novo;
+    }
+
+    // Retorna a estimativa de frequência de 'key' (o mínimo entre as linhas).
+    uint32_t estimate(const Key& key) const {
+        size_t colunas[PROFUNDIDADE_MAXIMA];
+        calcularColunas(key, colunas);
+        uint32_t minimo = std::numeric_limits<uint32_t>::max();
+        for (size_t i = 0; i < m_profundidade; ++i)
+            minimo = std::min(minimo, m_contadores[colunas[i]]);
+        return minimo;
+    }
+
+    // Zera todos os contadores, mantendo a memória alocada.
+    void clear() {
+        std::fill(m_contadores.begin(), m_contadores.end(), 0u);
+        m_total = 0;
+    }
+
+    size_t largura() const { return m_largura; }
+    size_t profundidade() const { return m_profundidade; }
+    uint64_t total() const { return m_total; }
+    size_t memoriaBytes() const { return m_contadores.size() * sizeof(uint32_t); }
+
+    // ε = e / largura: fração de N que limita o erro de cada estimativa.
+    double epsilon() const { return std::exp(1.0) / static_cast<double>(m_largura); }
+    // δ = e^-profundidade: probabilidade de uma estimativa ultrapassar εN.
+    double delta() const { return std::exp(-static_cast<double>(m_profundidade)); }
+    // Erro máximo absoluto (εN) com probabilidade 1 - δ, para o total contado até agora.
+    double erroMaximo() const { return epsilon() * static_cast<double>(m_total); }
+};
+
+#endif // COUNT_MIN_SKETCH_HPP
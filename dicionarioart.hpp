@@ -0,0 +1,92 @@
+#ifndef DICIONARIO_ART_HPP
+#define DICIONARIO_ART_HPP
+
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ARVORE_RADIX/ART.hpp" // Inclui o cabeçalho da Árvore Radix Adaptativa.
+
+// Dicionário baseado na Árvore Radix Adaptativa (ART).
+// Mantém a mesma interface do DicionarioAvl; a ordem de saída de getAllOrdered é a mesma.
+// A ART indexa bytes, por isso a chave precisa ser std::string.
+// 'Stats' escolhe a instrumentação da árvore (CountingStats ou NullStats).
+template<typename Key, typename Value, typename Stats = CountingStats>
+class DicionarioArt {
+    static_assert(std::is_same<Key, std::string>::value, "DicionarioArt exige chaves std::string");
+
+private:
+    ArtTree<Value, Stats> m_art;
+
+public:
+    // Adiciona um par chave-valor ao dicionário (ou atualiza se a chave já existe).
+    void add(const Key& key, const Value& value) {
+        m_art.Insert(key, value);
+    }
+
+    // Remove uma chave do dicionário.
+    void remove(const Key& key) {
+        m_art.Erase(key);
+    }
+
+    // Verifica se uma chave específica está presente no dicionário.
+    bool contains(const Key& key) const {
+        return m_art.Contains(key);
+    }
+
+    // Retorna o valor (frequência) associado a uma chave, ou 0 se ela não existir.
+    Value count(const Key& key) const {
+        return m_art.getCount(key);
+    }
+
+    // Exibe todos os pares chave-valor em ordem crescente.
+    void show() const {
+        m_art.PrintInOrder([](const Key& k, const Value& v) {
+            std::cout << k << ":" << v << " ";
+        });
+        std::cout << std::endl;
+    }
+
+    // Limpa o dicionário, removendo todos os pares chave-valor.
+    void clear() {
+        m_art.Clear();
+    }
+
+    // Troca os nós internos que ficaram grandes demais (após remoções) pela menor variante.
+    void shrink_to_fit() {
+        m_art.Compact();
+    }
+
+    // Verifica se o dicionário está vazio.
+    bool empty() const {
+        return m_art.Empty();
+    }
+
+    // Retorna o número de elementos únicos (chaves) no dicionário.
+    size_t size() const {
+        return m_art.Size();
+    }
+
+    // Retorna um vetor contendo todos os pares chave-valor, em ordem crescente.
+    std::vector<std::pair<Key, Value>> getAllOrdered() const {
+        return m_art.ToVector();
+    }
+
+    // Retorna, em ordem crescente, todos os pares cuja chave começa com 'prefixo'.
+    std::vector<std::pair<Key, Value>> getAllWithPrefix(const Key& prefixo) const {
+        std::vector<std::pair<Key, Value>> result;
+        m_art.ForEachWithPrefix(prefixo, [&result](const Key& k, const Value& v) {
+            result.emplace_back(k, v);
+        });
+        return result;
+    }
+
+    // Métodos para acessar as métricas de desempenho da ART interna
+    long long getComparacoesPrincipais() const { return m_art.getComparacoesPrincipais(); }
+    long long getCrescimentos() const { return m_art.getCrescimentos(); }
+    void resetComparacoes() { m_art.resetComparacoes(); }
+    void resetCrescimentos() { m_art.resetCrescimentos(); }
+};
+
+#endif // DICIONARIO_ART_HPP
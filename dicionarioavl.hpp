@@ -6,12 +6,13 @@
 #include <vector>
 #include "ARVORE_AVL/Set.hpp" // Inclui o cabeçalho da classe Set baseada em AVL.
 
-template<typename Key, typename Value>
+// 'Stats' escolhe a instrumentação da árvore (CountingStats ou NullStats).
+template<typename Key, typename Value, typename Stats = CountingStats>
 class DicionarioAvl {
 private:
     // A implementação do dicionário utiliza uma instância da classe Set (agora um Map AVL).
     // O Set armazena Key e Value separadamente, e balanceia pela Key.
-    Set<Key, Value> m_avl;
+    Set<Key, Value, std::less<Key>, Stats> m_avl;
 
 public:
     // Adiciona um par chave-valor ao dicionário.
@@ -20,6 +21,17 @@ public:
         m_avl.Insert(key, value);
     }
 
+    // Interface usada pelo CacheRecente: posição estável do contador de uma chave.
+    using Posicao = Value*;
+
+    // Posição do valor da chave, inserida com Value{} se ainda não existir (uma só descida).
+    Posicao localizar_ou_inserir(const Key& key) { return m_avl.FindOrInsert(key); }
+    void incrementar(Posicao posicao) { ++*posicao; }
+    static Value& valor(Posicao posicao) { return *posicao; }
+
+    // As rotações não movem nós: só remoções (e clear) mudam a versão e invalidam posições.
+    size_t versao() const { return m_avl.Versao(); }
+
     // Remove uma chave do dicionário.
     void remove(const Key& key) {
         m_avl.Erase(key);
@@ -54,6 +66,10 @@ public:
         m_avl.Clear();
     }
 
+    // Nada a compactar: a AVL libera cada nó na remoção. Existe para manter a interface
+    // igual à dos dicionários baseados em tabela hash.
+    void shrink_to_fit() {}
+
     // Verifica se o dicionário está vazio.
     bool empty() const {
         return m_avl.Empty();
@@ -89,6 +105,16 @@ public:
         return m_avl.ToVector();
     }
 
+    // Mesmo que getAllOrdered, no formato dos outros dicionários (preenche 'out').
+    void getAllPairs(std::vector<std::pair<Key, Value>>& out) const {
+        out = m_avl.ToVector();
+    }
+
+    // Forma da árvore, com os caminhos de busca ponderados pelo valor (frequência) de cada chave.
+    EstatisticasArvore estatisticasForma() const {
+        return m_avl.EstatisticasForma([](const Key&, const Value& v) { return v; });
+    }
+
     // Métodos para acessar as métricas de desempenho da AVL interna
     long long getComparacoesPrincipais() const { return m_avl.getComparacoesPrincipais(); }
     long long getRotacoes() const { return m_avl.getRotacoes(); }
@@ -5,11 +5,13 @@
 #include <vector>
 #include <utility> // Para std::pair
 
-template<typename Key, typename Value>
+// 'Reordenacao' escolhe a política das cadeias (OrdemInsercao, MoverParaFrente ou Transpor).
+// 'Stats' escolhe a instrumentação da tabela (CountingStats ou NullStats).
+template<typename Key, typename Value, typename Reordenacao = OrdemInsercao, typename Stats = CountingStats>
 class DicionarioChained {
 private:
     
-    ChainedHashTable<Key, Value> m_chainedHash;
+    ChainedHashTable<Key, Value, std::hash<Key>, Reordenacao, Stats> m_chainedHash;
 
 public:
     // Construtor do dicionário. Passa os parâmetros iniciais para a ChainedHashTable interna.
@@ -23,6 +25,17 @@ public:
         m_chainedHash.add(key, value);
     }
 
+    // Interface usada pelo CacheRecente: posição estável do contador de uma chave.
+    using Posicao = Value*;
+
+    // Posição do valor da chave, inserida com Value() se ainda não existir.
+    Posicao localizar_ou_inserir(const Key& key) { return m_chainedHash.find_or_insert(key); }
+    void incrementar(Posicao posicao) { ++*posicao; }
+    static Value& valor(Posicao posicao) { return *posicao; }
+
+    // O rehash só religa os nós das listas: só remoções mudam a versão.
+    size_t versao() const { return m_chainedHash.versao(); }
+
     // Verifica se uma chave específica está presente no dicionário.
     // :: Corrigido :: Agora aceita APENAS a chave, como deveria ser para 'contains'.
     bool contains(const Key& key) const {
@@ -56,6 +69,16 @@ public:
 
     // Retorna o número de elementos únicos no dicionário.
     size_t size() const { return m_chainedHash.size(); }
+    // Retorna o número de buckets da tabela interna.
+    size_t bucket_count() const { return m_chainedHash.bucket_count(); }
+
+    // Reserva espaço para 'n' palavras distintas, evitando rehashes durante a contagem.
+    void reserve(size_t n) { m_chainedHash.reserve(n); }
+    // Reduz a tabela ao menor tamanho que comporta as palavras atuais (ex.: após podar as raras).
+    void shrink_to_fit() { m_chainedHash.shrink_to_fit(); }
+
+    // Histogramas de cadeias e sondagens da tabela interna.
+    EstatisticasHash estatisticas() const { return m_chainedHash.estatisticas(); }
 
     void show() const {
     m_chainedHash.show();
@@ -0,0 +1,71 @@
+#ifndef DICIONARIO_CUCKOO_HPP
+#define DICIONARIO_CUCKOO_HPP
+
+#include <utility>
+#include <vector>
+#include "hash_cuckoo.hpp" // Tabela hash cuckoo com baldes de 4 posições
+
+// Dicionário sobre a tabela cuckoo. Mesma interface do DicionarioChained; buscas examinam no
+// máximo dois baldes e o estoque, qualquer que seja a ocupação.
+// 'Stats' escolhe a instrumentação da tabela (CountingStats ou NullStats).
+template<typename Key, typename Value, typename Stats = CountingStats>
+class DicionarioCuckoo {
+private:
+    HashCuckoo<Key, Value, std::hash<Key>, Stats> m_tabela;
+
+public:
+    // Fator de carga padrão 0.95 (baldes de 4 posições toleram alta ocupação).
+    DicionarioCuckoo(size_t tableSize = 19, float load_factor = 0.95f)
+        : m_tabela(tableSize, load_factor) {}
+
+    // Adiciona um par chave-valor (ou atualiza o valor se a chave já existe).
+    void add(const Key& key, const Value& value) {
+        m_tabela.insert(key, value);
+    }
+
+    // Verifica se uma chave está no dicionário.
+    bool contains(const Key& key) const {
+        return m_tabela.contains(key);
+    }
+
+    // Retorna o valor (frequência) da chave, ou Value() se ela não existir.
+    Value count(const Key& key) const {
+        return m_tabela.count(key);
+    }
+
+    // Remove uma chave do dicionário.
+    void remove(const Key& key) {
+        m_tabela.remove(key);
+    }
+
+    // Coleta todos os pares chave-valor do dicionário em um vetor.
+    void getAllPairs(std::vector<std::pair<Key, Value>>& out) const {
+        m_tabela.getAllPairs(out);
+    }
+
+    // Métricas de desempenho da tabela interna
+    long long getComparacoesPrincipais() const { return m_tabela.getComparacoesPrincipais(); }
+    long long getContadorRehash() const { return m_tabela.getRehashes(); }
+    // Elementos movidos para o balde alternativo durante inserções (análogo das rotações).
+    long long getDeslocamentos() const { return m_tabela.getDeslocamentos(); }
+    size_t tamanhoEstoque() const { return m_tabela.stash_size(); }
+    void resetComparacoes() { m_tabela.resetComparacoes(); }
+    void resetRehash() { m_tabela.resetRehash(); }
+    void resetDeslocamentos() { m_tabela.resetDeslocamentos(); }
+
+    // Distribuição das sondagens da tabela.
+    EstatisticasHash estatisticas() const { return m_tabela.estatisticas(); }
+
+    size_t size() const { return m_tabela.size(); }
+    // Reserva espaço para 'n' palavras distintas, evitando rehashes durante a contagem.
+    void reserve(size_t n) { m_tabela.reserve(n); }
+    // Reduz a tabela ao menor tamanho que comporta as palavras atuais (ex.: após podar as raras).
+    void shrink_to_fit() { m_tabela.shrink_to_fit(); }
+    size_t bucket_count() const { return m_tabela.bucket_count(); }
+
+    void show() const {
+        m_tabela.show();
+    }
+};
+
+#endif // DICIONARIO_CUCKOO_HPP
@@ -4,11 +4,12 @@
 #include "hash_aberto.hpp" 
 
 // Esta é a classe DicionarioOpen, ela "empacota" sua HashAberto para ser usada como um dicionário
-template<typename Key, typename Value> // Ela funciona com qualquer tipo de Chave (Key) e Valor (Value)
+// 'Stats' escolhe a instrumentação da tabela (CountingStats ou NullStats).
+template<typename Key, typename Value, typename Stats = CountingStats> // Ela funciona com qualquer tipo de Chave (Key) e Valor (Value)
 class DicionarioOpen {
 private:
     // Aqui criamos uma instância da sua HashAberto, é onde os dados serão realmente guardados
-    HashAberto<Key, Value> tabela;
+    HashAberto<Key, Value, std::hash<Key>, Stats> tabela;
 
 public:
     // Adiciona uma chave e um valor ao dicionário (ou atualiza se a chave já existe)
@@ -16,6 +17,20 @@ public:
         tabela.insert(k, v); // Chama a função 'insert' da HashAberto
     }
 
+    // Interface usada pelo CacheRecente: posição do contador de uma chave.
+    using Posicao = Value*;
+
+    // Posição do valor da chave, inserida com Value() se ainda não existir.
+    Posicao localizar_ou_inserir(const Key& k) { return tabela.find_or_insert(k); }
+    void incrementar(Posicao posicao) { ++*posicao; }
+    static Value& valor(Posicao posicao) { return *posicao; }
+
+    // Muda a cada realocação dos slots (rehash) e a cada remoção: as posições anteriores deixam de valer.
+    size_t versao() const { return tabela.versao(); }
+
+    // Número de slots da tabela
+    size_t bucket_count() const { return tabela.bucket_count(); }
+
     // Remove uma chave do dicionário
     void remover(const Key& k) {
         tabela.remove(k); // Chama a função 'remove' da HashAberto
@@ -55,6 +70,16 @@ public:
         tabela.show();
     }
 
+    // Reserva espaço para 'n' chaves distintas, evitando rehashes durante as inserções
+    void reserve(size_t n) {
+        tabela.reserve(n);
+    }
+
+    // Reconstrói a tabela no menor tamanho que comporta as chaves atuais, sem marcas de remoção
+    void shrink_to_fit() {
+        tabela.shrink_to_fit();
+    }
+
     // Retorna quantas comparações de chaves foram feitas (para medir desempenho)
     size_t getComparacoesPrincipais() const {
         return tabela.getComparacoesPrincipais();
@@ -65,6 +90,11 @@ public:
         return tabela.getRehashes(); // Note que o nome na HashAberto é 'getRehashes'
     }
 
+    // Retorna a distribuição das sondagens da tabela (para ajustar fator de carga e hash)
+    EstatisticasHash estatisticas() const {
+        return tabela.estatisticas();
+    }
+
     // Pega todos os pares de chave-valor e coloca em um vetor (lista)
     void getAllPairs(std::vector<std::pair<Key, Value>>& pares) const {
         pares.clear(); // Limpa o vetor antes de preencher
@@ -8,12 +8,13 @@
 
 // Define a classe DicionarioRb, que atua como uma 'interface' para sua RBTree.
 // Ela permite usar a RBTree de forma mais amigável, como um dicionário.
-template <typename Key, typename Value> // É um template, pode funcionar com qualquer tipo de Chave e Valor
+// 'Stats' escolhe a instrumentação da árvore (CountingStats ou NullStats).
+template <typename Key, typename Value, typename Stats = CountingStats> // É um template, pode funcionar com qualquer tipo de Chave e Valor
 class DicionarioRb {
 private:
     // rb_tree é a sua Árvore Rubro-Negra real.
     // Ela é o "motor" que guarda e organiza os dados.
-    rbtree<Key, Value> rb_tree; 
+    rbtree<Key, Value, Stats> rb_tree;
 
 public:
     // Método para adicionar um par (chave e valor) ao dicionário.
@@ -22,6 +23,21 @@ public:
         rb_tree.insert(key, value);
     }
 
+    // Interface usada pelo CacheRecente: posição estável do contador de uma chave.
+    // O nó guarda o valor e as ocorrências; incrementar atualiza os dois, como add(k, count(k) + 1).
+    using Posicao = RBNode<std::pair<Key, Value>>*;
+
+    // Nó da chave, inserida com valor e ocorrências zerados se ainda não existir (uma só descida).
+    Posicao localizar_ou_inserir(const Key& key) { return rb_tree.findOrInsert(key); }
+    void incrementar(Posicao node) {
+        ++node->key_value.second;
+        ++node->ocorrencias;
+    }
+    static Value& valor(Posicao node) { return node->key_value.second; }
+
+    // As rotações não movem nós: só remoções (e clear) mudam a versão e invalidam posições.
+    size_t versao() const { return rb_tree.versao(); }
+
     // Método para remover uma chave (e seu valor) do dicionário.
     // Ele delega a tarefa para o método 'remove' da sua RBTree.
     void remove(const Key& key) {
@@ -74,6 +90,10 @@ public:
         rb_tree.clear();
     }
 
+    // Nada a compactar: a rubro-negra libera cada nó na remoção.
+    // Existe para manter a interface igual à dos outros dicionários.
+    void shrink_to_fit() {}
+
     // Retorna o número de comparações de chaves realizadas na RBTree.
     // Usado para medir o desempenho.
     long long getComparacoesPrincipais() const {
@@ -96,6 +116,12 @@ public:
         rb_tree.resetRotacoes();
     }
 
+    // Retorna a forma da árvore (altura, altura negra, nós por nível e caminhos de busca
+    // ponderados pelas ocorrências de cada chave).
+    EstatisticasArvore estatisticasForma() const {
+        return rb_tree.estatisticasForma();
+    }
+
     // Coleta todos os pares (chave e valor) do dicionário e os adiciona a um vetor.
     // Os pares serão coletados em ordem, pois árvores de busca mantêm essa propriedade.
     void getAllPairs(std::vector<std::pair<Key, Value>>& out_vector) const {
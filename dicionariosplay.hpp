@@ -0,0 +1,61 @@
+#ifndef DICIONARIO_SPLAY_HPP
+#define DICIONARIO_SPLAY_HPP
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "ARVORE_SPLAY/SplayTree.hpp"
+
+// Dicionário sobre a árvore splay: mesma interface dos dicionários rb e avl.
+// As consultas (count, contains, at) trazem a chave para a raiz, por isso não são const;
+// no padrão count + add do contador de frequências, o add encontra a chave já na raiz.
+// 'Stats' escolhe a instrumentação da árvore (CountingStats ou NullStats).
+template <typename Key, typename Value, typename Stats = CountingStats>
+class DicionarioSplay {
+private:
+    SplayTree<Key, Value, Stats> m_arvore;
+
+public:
+    // Adiciona o par ou atualiza o valor se a chave já existe.
+    void add(const Key& key, const Value& value) { m_arvore.insert(key, value); }
+
+    void remove(const Key& key) { m_arvore.remove(key); }
+
+    bool contains(const Key& key) { return m_arvore.contains(key); }
+
+    // Valor associado à chave; lança std::out_of_range se ela não existir.
+    Value at(const Key& key) {
+        Value* valor = m_arvore.find(key);
+        if (!valor) throw std::out_of_range("Chave nao encontrada no dicionario.");
+        return *valor;
+    }
+
+    // Valor (frequência) associado à chave ou Value() se ela não existir.
+    Value count(const Key& key) { return m_arvore.count(key); }
+
+    bool empty() const { return m_arvore.empty(); }
+    size_t size() const { return m_arvore.size(); }
+    void clear() { m_arvore.clear(); }
+
+    // Nada a compactar: a splay libera cada nó na remoção.
+    // Existe para manter a interface igual à dos outros dicionários.
+    void shrink_to_fit() {}
+
+    // Pares (chave, valor) em ordem crescente de chave.
+    void getAllPairs(std::vector<std::pair<Key, Value>>& out_vector) const { m_arvore.inorderCollect(out_vector); }
+
+    // Forma da árvore, com os caminhos de busca ponderados pelo valor (frequência) de cada chave.
+    EstatisticasArvore estatisticasForma() const {
+        return m_arvore.estatisticasForma([](const Key&, const Value& v) { return v; });
+    }
+
+    void show() const { m_arvore.bshow(); }
+
+    // Métricas da árvore splay interna
+    long long getComparacoesPrincipais() const { return m_arvore.getComparacoesPrincipais(); }
+    long long getRotacoes() const { return m_arvore.getRotacoes(); }
+    void resetComparacoes() { m_arvore.resetComparacoes(); }
+    void resetRotacoes() { m_arvore.resetRotacoes(); }
+};
+
+#endif // DICIONARIO_SPLAY_HPP
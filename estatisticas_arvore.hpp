@@ -0,0 +1,84 @@
+#ifndef ESTATISTICAS_ARVORE_HPP
+#define ESTATISTICAS_ARVORE_HPP
+
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+// Forma de uma árvore de busca num dado momento, calculada percorrendo todos os nós.
+// Níveis e caminhos contam nós a partir da raiz (a raiz está no nível 1), ou seja, o
+// comprimento do caminho até um nó é o número de comparações de uma busca bem-sucedida.
+// Cada nó tem um peso (sua frequência de acesso); com ele é possível estimar o custo
+// de uma carga real e quanto dele é gasto nos níveis de cima.
+struct EstatisticasArvore {
+    bool rubro_negra = false;
+    size_t nos = 0;
+    int altura = 0;
+    int altura_negra = 0;                // Nós pretos da raiz até uma folha NIL (só rubro-negra)
+    bool altura_negra_uniforme = true;   // Todos os caminhos têm a mesma altura negra
+    double peso_total = 0.0;
+    std::vector<size_t> nos_por_nivel;   // Posição 0 = nível 1 (raiz)
+    std::vector<double> peso_por_nivel;  // Soma dos pesos dos nós de cada nível
+
+    // Registra um nó no nível 'nivel' (1 = raiz) com o peso dado.
+    void registrar(int nivel, double peso) {
+        if (static_cast<int>(nos_por_nivel.size()) < nivel) {
+            nos_por_nivel.resize(nivel, 0);
+            peso_por_nivel.resize(nivel, 0.0);
+        }
+        nos_por_nivel[nivel - 1]++;
+        peso_por_nivel[nivel - 1] += peso;
+        nos++;
+        peso_total += peso;
+        if (nivel > altura) altura = nivel;
+    }
+
+    // Caminho médio de busca considerando todas as chaves igualmente prováveis.
+    double caminhoMedio() const {
+        double soma = 0.0;
+        for (size_t i = 0; i < nos_por_nivel.size(); ++i) soma += static_cast<double>(i + 1) * nos_por_nivel[i];
+        return nos ? soma / static_cast<double>(nos) : 0.0;
+    }
+
+    // Caminho médio de busca ponderado pela frequência de acesso.
+    double caminhoMedioPonderado() const { return peso_total > 0 ? comparacoesPonderadas() / peso_total : 0.0; }
+
+    // Total de comparações se cada chave fosse buscada 'peso' vezes.
+    double comparacoesPonderadas() const {
+        double soma = 0.0;
+        for (size_t i = 0; i < peso_por_nivel.size(); ++i) soma += static_cast<double>(i + 1) * peso_por_nivel[i];
+        return soma;
+    }
+
+    // Comparações feitas no nível 'nivel': toda busca por um nó naquele nível ou abaixo passa por ele.
+    double comparacoesNoNivel(int nivel) const {
+        double soma = 0.0;
+        for (size_t i = static_cast<size_t>(nivel - 1); i < peso_por_nivel.size(); ++i) soma += peso_por_nivel[i];
+        return soma;
+    }
+
+    void escrever(std::ostream& saida) const {
+        saida << std::fixed << std::setprecision(3);
+        saida << "forma da árvore:\n";
+        saida << "  nós: " << nos << ", altura: " << altura << "\n";
+        if (rubro_negra) {
+            saida << "  altura negra: " << altura_negra;
+            if (!altura_negra_uniforme) saida << " (INCONSISTENTE entre caminhos)";
+            saida << "\n";
+        }
+        saida << "  caminho de busca: médio " << caminhoMedio() << ", médio ponderado pela frequência "
+              << caminhoMedioPonderado() << ", máximo " << altura << "\n";
+        saida << "  nível: nós, % das comparações (acumulado)\n";
+        double total = comparacoesPonderadas();
+        double acumulado = 0.0;
+        for (size_t i = 0; i < nos_por_nivel.size(); ++i) {
+            double fracao = total > 0 ? comparacoesNoNivel(static_cast<int>(i + 1)) / total : 0.0;
+            acumulado += fracao;
+            saida << "    " << (i + 1) << ": " << nos_por_nivel[i] << ", "
+                  << fracao * 100.0 << "% (" << acumulado * 100.0 << "%)\n";
+        }
+    }
+};
+
+#endif // ESTATISTICAS_ARVORE_HPP
@@ -0,0 +1,75 @@
+#ifndef ESTATISTICAS_HASH_HPP
+#define ESTATISTICAS_HASH_HPP
+
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+// Retrato da distribuição de uma tabela hash num dado momento, calculado percorrendo a tabela
+// (não há custo durante as inserções). Os comprimentos de sondagem assumem que cada posição
+// inicial é igualmente provável, como num hash uniforme:
+// - sucesso: slots (ou elementos da cadeia) examinados até achar cada chave presente;
+// - falha: slots (ou elementos) examinados por uma busca que começa em cada bucket e não acha a chave.
+// Histogramas: a posição i guarda quantas buscas examinaram exatamente i slots/elementos.
+struct EstatisticasHash {
+    bool enderecamento_aberto = false;
+    size_t buckets = 0;
+    size_t elementos = 0;
+    size_t removidos = 0;                    // Slots REMOVIDO (só no endereçamento aberto)
+    size_t deslocamento_maximo = 0;          // Maior distância entre o slot ideal e o slot real
+    std::vector<size_t> sondagem_sucesso;
+    std::vector<size_t> sondagem_falha;
+    std::vector<size_t> comprimento_cadeia;  // Buckets com i elementos (só no encadeamento)
+
+    static void registrar(std::vector<size_t>& histograma, size_t valor) {
+        if (histograma.size() <= valor) histograma.resize(valor + 1, 0);
+        histograma[valor]++;
+    }
+
+    static double media(const std::vector<size_t>& histograma) {
+        size_t total = 0, soma = 0;
+        for (size_t i = 0; i < histograma.size(); ++i) {
+            total += histograma[i];
+            soma += i * histograma[i];
+        }
+        return total ? static_cast<double>(soma) / static_cast<double>(total) : 0.0;
+    }
+
+    static size_t maximo(const std::vector<size_t>& histograma) {
+        return histograma.empty() ? 0 : histograma.size() - 1;
+    }
+
+    double fatorCarga() const { return buckets ? static_cast<double>(elementos) / buckets : 0.0; }
+    // Fração dos slots ocupada por marcas de remoção.
+    double taxaRemovidos() const { return buckets ? static_cast<double>(removidos) / buckets : 0.0; }
+
+    // Escreve o resumo e os histogramas (apenas as entradas não nulas).
+    void escrever(std::ostream& saida) const {
+        saida << std::fixed << std::setprecision(3);
+        saida << "estatísticas da tabela hash:\n";
+        saida << "  buckets: " << buckets << ", elementos: " << elementos
+              << ", fator de carga: " << fatorCarga() << "\n";
+        if (enderecamento_aberto) {
+            saida << "  slots removidos: " << removidos << " (" << taxaRemovidos() * 100.0 << "%)\n";
+            saida << "  deslocamento máximo: " << deslocamento_maximo << "\n";
+        }
+        saida << "  sondagem com sucesso: média " << media(sondagem_sucesso)
+              << ", máximo " << maximo(sondagem_sucesso) << "\n";
+        saida << "  sondagem sem sucesso: média " << media(sondagem_falha)
+              << ", máximo " << maximo(sondagem_falha) << "\n";
+        escreverHistograma(saida, "histograma de sondagens com sucesso", sondagem_sucesso);
+        escreverHistograma(saida, "histograma de sondagens sem sucesso", sondagem_falha);
+        if (!enderecamento_aberto)
+            escreverHistograma(saida, "histograma de comprimento das cadeias", comprimento_cadeia);
+    }
+
+private:
+    static void escreverHistograma(std::ostream& saida, const char* titulo, const std::vector<size_t>& histograma) {
+        saida << "  " << titulo << " (comprimento: quantidade):\n";
+        for (size_t i = 0; i < histograma.size(); ++i)
+            if (histograma[i]) saida << "    " << i << ": " << histograma[i] << "\n";
+    }
+};
+
+#endif // ESTATISTICAS_HASH_HPP
@@ -2,13 +2,18 @@
 #define HASH_ABERTO_HPP
 
 #include <vector>
+#include <algorithm>
 #include <functional>
 #include <stdexcept>
 #include <utility>
 #include <optional>
 #include <iostream>
+#include "estatisticas_hash.hpp"
+#include "tamanho_primo.hpp"
+#include "politica_estatisticas.hpp"
 
-template <typename Key, typename Value, typename Hash = std::hash<Key>>
+// 'Stats' escolhe a instrumentação: CountingStats (comparações e rehashes) ou NullStats (nenhuma).
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Stats = CountingStats>
 class HashAberto {
 private:
     enum class Estado { VAZIO, OCUPADO, REMOVIDO };
@@ -17,76 +22,87 @@ private:
         std::optional<Key> chave;
         std::optional<Value> valor;
         int contador = 0;
+        size_t hash = 0; // Hash completo da chave (reaproveitado no rehash)
         Estado estado = Estado::VAZIO;
         Slot() = default;
     };
 
     std::vector<Slot> m_table;
     size_t m_table_size;
+    TamanhoPrimo m_tamanho; // Primo da escada e redução rápida (fastmod) do hash
     size_t m_number_of_elements;
+    size_t m_removidos = 0; // slots marcados REMOVIDO (alongam as sondagens até o próximo rehash)
+    size_t m_versao = 0; // realocações dos slots e remoções (ver versao())
     float m_max_load_factor;
     Hash m_hashing;
 
-    mutable long m_comparacoes_principais = 0; // contador comparações de chaves
-    size_t m_rehashes = 0;                // contador de rehashes
+    Stats m_stats; // contadores de comparações de chaves e de rehashes
 
-    size_t hash_code(const Key& k) const {
-        return m_hashing(k) % m_table_size;
+    // Remoções que deixam o fator de carga abaixo de 1/4 do máximo encolhem a tabela
+    // (para a metade do máximo), nunca abaixo do tamanho padrão.
+    static constexpr float FRACAO_ENCOLHIMENTO = 0.25f;
+    static constexpr size_t TAMANHO_MINIMO = 19;
+
+    // Menor número de slots com que 'n' elementos ficam abaixo do fator de carga máximo.
+    size_t minimo_para(size_t n) const {
+        return static_cast<size_t>(n / m_max_load_factor) + 1;
+    }
+
+    // Slot ideal do hash h (h % m_table_size sem instrução de divisão).
+    size_t slot_ideal(size_t h) const {
+        return m_tamanho.reduzir(h);
+    }
+
+    // Próximo slot da sondagem linear.
+    size_t proximo_slot(size_t j) const {
+        return (j + 1 == m_table_size) ? 0 : j + 1;
+    }
+
+    // Passa a tabela para o primo da escada >= 'tamanho', com todos os slots vazios.
+    void alocar(size_t tamanho) {
+        m_tamanho.ajustar(tamanho);
+        m_table_size = m_tamanho.tamanho();
+        m_table.clear();
+        m_table.resize(m_table_size);
+        m_removidos = 0;
+        ++m_versao;
     }
 
     int aux_hash_search(const Key& k) const {
-        size_t i = 0;
-        while (i < m_table_size) {
-            size_t j = (hash_code(k) + i) % m_table_size;
+        size_t h = m_hashing(k);
+        size_t j = slot_ideal(h);
+        for (size_t i = 0; i < m_table_size; ++i, j = proximo_slot(j)) {
             if (m_table[j].estado == Estado::OCUPADO) {
-                m_comparacoes_principais++; // comparação de chave
-                if (m_table[j].chave && *(m_table[j].chave) == k) {
+                m_stats.comparacao(); // comparação de chave
+                if (m_table[j].hash == h && m_table[j].chave && *(m_table[j].chave) == k) {
                     return static_cast<int>(j);
                 }
             }
             if (m_table[j].estado == Estado::VAZIO) {
                 return -1;
             }
-            ++i;
         }
         return -1;
     }
 
-public:
-    HashAberto(size_t tableSize = 19, float load_factor = 0.7)
-        : m_table_size(tableSize), m_number_of_elements(0), m_max_load_factor(load_factor) {
-        m_table.resize(m_table_size);
-    }
-
-    size_t size() const { return m_number_of_elements; }
-    bool empty() const { return m_number_of_elements == 0; }
-    size_t bucket_count() const { return m_table_size; }
-    float load_factor() const { return static_cast<float>(m_number_of_elements) / m_table_size; }
-    float max_load_factor() const { return m_max_load_factor; }
-
-    void clear() {
-        m_table.clear();
-        m_table.resize(m_table_size);
-        m_number_of_elements = 0;
-        m_comparacoes_principais = 0;
-        m_rehashes = 0;
-    }
-
-    bool insert(const Key& k, const Value& v) {
+    // Busca a chave ou a insere com 'v' no primeiro slot livre da sondagem (podendo fazer rehash
+    // antes). Retorna o índice do slot ou -1 se a tabela estiver cheia.
+    int inserir_ou_localizar(const Key& k, const Value& v, bool& inserido) {
         if (load_factor() > m_max_load_factor) {
-            rehash(m_table_size * 2 + 1);
+            rehash(TamanhoPrimo::crescer(m_table_size)); // Dois degraus da escada (~2x)
+        } else if (m_removidos && m_number_of_elements + m_removidos >= m_max_load_factor * m_table_size) {
+            // Marcas de remoção ocupam a tabela: reconstrói sem elas (carga na metade do máximo).
+            rehash(static_cast<size_t>(2 * m_number_of_elements / m_max_load_factor));
         }
-        size_t i = 0;
+        size_t h = m_hashing(k); // calculado uma vez; a sondagem só avança o índice
+        size_t j = slot_ideal(h);
         int index = -1;
-        while (i < m_table_size) {
-            size_t j = (hash_code(k) + i) % m_table_size;
-
+        for (size_t i = 0; i < m_table_size; ++i, j = proximo_slot(j)) {
             if (m_table[j].estado == Estado::OCUPADO) {
-                m_comparacoes_principais++; // comparação chave
-                if (m_table[j].chave && *(m_table[j].chave) == k) {
-                    m_table[j].valor = v;
-                    m_table[j].contador++;
-                    return true;
+                m_stats.comparacao(); // comparação chave
+                if (m_table[j].hash == h && m_table[j].chave && *(m_table[j].chave) == k) {
+                    inserido = false;
+                    return static_cast<int>(j);
                 }
             } else if (m_table[j].estado == Estado::VAZIO) {
                 if (index == -1)
@@ -96,34 +112,88 @@ public:
                 if (index == -1)
                     index = j;
             }
-            ++i;
         }
         if (index != -1) {
+            if (m_table[index].estado == Estado::REMOVIDO) --m_removidos;
             m_table[index].chave = k;
             m_table[index].valor = v;
             m_table[index].contador = 1;
+            m_table[index].hash = h;
             m_table[index].estado = Estado::OCUPADO;
             ++m_number_of_elements;
-            return true;
+            inserido = true;
+            return index;
         }
-        return false;
+        inserido = false;
+        return -1;
+    }
+
+public:
+    // 'tableSize' é arredondado para o próximo primo da escada.
+    HashAberto(size_t tableSize = 19, float load_factor = 0.7)
+        : m_number_of_elements(0), m_max_load_factor(load_factor) {
+        alocar(tableSize);
     }
 
+    size_t size() const { return m_number_of_elements; }
+    bool empty() const { return m_number_of_elements == 0; }
+    size_t bucket_count() const { return m_table_size; }
+    float load_factor() const { return static_cast<float>(m_number_of_elements) / m_table_size; }
+    float max_load_factor() const { return m_max_load_factor; }
+
+    void clear() {
+        m_table.clear();
+        m_table.resize(m_table_size);
+        m_number_of_elements = 0;
+        m_removidos = 0;
+        ++m_versao;
+        m_stats.resetComparacoes();
+        m_stats.resetReestruturacoes();
+    }
+
+    bool insert(const Key& k, const Value& v) {
+        bool inserido;
+        int j = inserir_ou_localizar(k, v, inserido);
+        if (j == -1) return false;
+        if (!inserido) {
+            m_table[j].valor = v;
+            m_table[j].contador++;
+        }
+        return true;
+    }
+
+    // Endereço do valor da chave, inserida com Value() se ainda não existir (nullptr se a tabela
+    // estiver cheia). Vale até a próxima realocação dos slots ou remoção (versao() muda).
+    Value* find_or_insert(const Key& k) {
+        bool inserido;
+        int j = inserir_ou_localizar(k, Value(), inserido);
+        return j == -1 ? nullptr : &*m_table[j].valor;
+    }
+
+    // Muda sempre que os slots são realocados (rehash, reserve, shrink_to_fit) e a cada remoção
+    // (o slot REMOVIDO pode ser reaproveitado por outra chave): endereços obtidos com
+    // find_or_insert antes disso não valem mais.
+    size_t versao() const { return m_versao; }
+
     bool remove(const Key& k) {
-        size_t i = 0;
-        while (i < m_table_size) {
-            size_t j = (hash_code(k) + i) % m_table_size;
+        size_t h = m_hashing(k);
+        size_t j = slot_ideal(h);
+        for (size_t i = 0; i < m_table_size; ++i, j = proximo_slot(j)) {
             if (m_table[j].estado == Estado::OCUPADO) {
-                m_comparacoes_principais++; // comparação chave
-                if (m_table[j].chave && *(m_table[j].chave) == k) {
+                m_stats.comparacao(); // comparação chave
+                if (m_table[j].hash == h && m_table[j].chave && *(m_table[j].chave) == k) {
                     m_table[j].estado = Estado::REMOVIDO;
                     --m_number_of_elements;
+                    ++m_removidos;
+                    ++m_versao;
+                    if (m_table_size > TamanhoPrimo::proximo(TAMANHO_MINIMO) &&
+                        load_factor() < FRACAO_ENCOLHIMENTO * m_max_load_factor)
+                        rehash(static_cast<size_t>(2 * m_number_of_elements / m_max_load_factor));
                     return true;
                 }
             } else if (m_table[j].estado == Estado::VAZIO) {
                 return false;
             }
-            ++i;
         }
         return false;
     }
@@ -144,37 +214,44 @@ public:
         return *(m_table[idx].valor);
     }
 
+    // Reconstrói a tabela com o primo da escada >= new_size, usando os hashes guardados.
+    // As marcas REMOVIDO são descartadas. O tamanho pode diminuir, mas nunca abaixo do
+    // necessário para os elementos atuais respeitarem o fator de carga máximo.
     void rehash(size_t new_size) {
-        m_rehashes++; // conta rehash
-        std::vector<Slot> old_table = m_table;
-        m_table_size = new_size;
-        m_table.clear();
-        m_table.resize(m_table_size);
+        m_stats.reestruturacao(); // conta rehash
+        new_size = std::max({new_size, minimo_para(m_number_of_elements), TAMANHO_MINIMO});
+        std::vector<Slot> old_table = std::move(m_table);
+        alocar(new_size);
         m_number_of_elements = 0;
 
-        for (const auto& slot : old_table) {
+        for (auto& slot : old_table) {
             if (slot.estado == Estado::OCUPADO && slot.chave && slot.valor) {
-                size_t i = 0;
-                int index = -1;
-                while (i < m_table_size) {
-                    size_t j = (hash_code(*(slot.chave)) + i) % m_table_size;
-                    if (m_table[j].estado != Estado::OCUPADO) {
-                        index = j;
-                        break;
-                    }
-                    ++i;
-                }
-                if (index != -1) {
-                    m_table[index].chave = slot.chave;
-                    m_table[index].valor = slot.valor;
-                    m_table[index].contador = slot.contador;
-                    m_table[index].estado = Estado::OCUPADO;
-                    ++m_number_of_elements;
-                }
+                size_t j = slot_ideal(slot.hash);
+                while (m_table[j].estado == Estado::OCUPADO) j = proximo_slot(j);
+                m_table[j] = std::move(slot);
+                ++m_number_of_elements;
             }
         }
     }
 
+    // Garante espaço para 'n' elementos sem rehash durante as inserções.
+    // Com a tabela vazia só realoca os slots (não conta como rehash).
+    void reserve(size_t n) {
+        size_t necessario = minimo_para(n);
+        if (necessario <= m_table_size) return;
+        if (m_number_of_elements == 0) {
+            alocar(necessario);
+        } else {
+            rehash(necessario);
+        }
+    }
+
+    // Reconstrói a tabela no menor primo da escada que comporta os elementos atuais:
+    // devolve os slots que sobraram e elimina todas as marcas REMOVIDO.
+    void shrink_to_fit() {
+        rehash(minimo_para(m_number_of_elements));
+    }
+
     void show() const {
         std::cout << "Indice\tEstado\tChave\tValor\tContador\n";
         for (size_t i = 0; i < m_table_size; ++i) {
@@ -191,9 +268,48 @@ public:
         }
     }
 
+    // Calcula a distribuição das sondagens percorrendo a tabela.
+    // Sucesso: deslocamento da chave em relação ao slot ideal + 1.
+    // Falha: slots não vazios (ocupados ou removidos) atravessados a partir de cada posição
+    // inicial até encontrar um slot VAZIO.
+    EstatisticasHash estatisticas() const {
+        EstatisticasHash e;
+        e.enderecamento_aberto = true;
+        e.buckets = m_table_size;
+        e.elementos = m_number_of_elements;
+        if (m_table_size == 0) return e;
+
+        size_t vazio = m_table_size; // Algum slot VAZIO, de onde a varredura para trás começa
+        for (size_t j = 0; j < m_table_size; ++j) {
+            const Slot& slot = m_table[j];
+            if (slot.estado == Estado::REMOVIDO) e.removidos++;
+            if (slot.estado == Estado::VAZIO && vazio == m_table_size) vazio = j;
+            if (slot.estado == Estado::OCUPADO) {
+                size_t ideal = slot_ideal(slot.hash);
+                size_t deslocamento = (j >= ideal) ? j - ideal : j + m_table_size - ideal;
+                if (deslocamento > e.deslocamento_maximo) e.deslocamento_maximo = deslocamento;
+                EstatisticasHash::registrar(e.sondagem_sucesso, deslocamento + 1);
+            }
+        }
+
+        if (vazio == m_table_size) {
+            // Sem slots vazios, toda busca sem sucesso percorre a tabela inteira.
+            for (size_t j = 0; j < m_table_size; ++j) EstatisticasHash::registrar(e.sondagem_falha, m_table_size);
+            return e;
+        }
+        // Andando para trás a partir de um slot vazio, o trecho não vazio à frente cresce de um em um.
+        size_t trecho = 0;
+        for (size_t passo = 0; passo < m_table_size; ++passo) {
+            size_t j = (vazio >= passo) ? vazio - passo : vazio + m_table_size - passo;
+            trecho = (m_table[j].estado == Estado::VAZIO) ? 0 : trecho + 1;
+            EstatisticasHash::registrar(e.sondagem_falha, trecho);
+        }
+        return e;
+    }
+
     // Getters para estatísticas
-    size_t getComparacoesPrincipais() const { return m_comparacoes_principais; }
-    size_t getRehashes() const { return m_rehashes; }
+    size_t getComparacoesPrincipais() const { return m_stats.comparacoes(); }
+    size_t getRehashes() const { return m_stats.reestruturacoes(); }
 
     // Para acessar todos pares para o DicionarioOpen
     // Retorna o par na posição i, ou lança exceção se vazio/removido
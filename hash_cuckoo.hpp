@@ -0,0 +1,406 @@
+#ifndef HASH_CUCKOO_HPP
+#define HASH_CUCKOO_HPP
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <cstdint>
+#include <iostream>
+#include "estatisticas_hash.hpp"
+#include "politica_estatisticas.hpp"
+
+// Tabela hash cuckoo com baldes: cada chave tem exatamente dois baldes possíveis (duas funções
+// hash) e cada balde tem 4 posições. Uma busca examina no máximo 2 x 4 posições mais o pequeno
+// estoque (stash), então o pior caso da busca é O(1), independente do fator de carga.
+// - Inserção: se os dois baldes estão cheios, uma busca em largura (BFS) no grafo de
+//   deslocamentos acha o caminho mais curto até um balde com vaga; os elementos do caminho
+//   passam para os seus baldes alternativos, do fim para o começo.
+// - Se nenhum caminho curto existe, a chave vai para o estoque; com o estoque cheio, a tabela dobra.
+// - Com 4 posições por balde a tabela funciona bem até ~95% de ocupação.
+// 'Stats' escolhe a instrumentação: CountingStats conta comparações e deslocamentos
+// (o análogo das rotações/rehashes), NullStats não conta nada.
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Stats = CountingStats>
+class HashCuckoo {
+public:
+    static constexpr unsigned POSICOES_POR_BALDE = 4;
+    static constexpr size_t ESTOQUE_MAXIMO = 4;     // Chaves que não couberam em nenhum balde
+    static constexpr size_t LIMITE_BUSCA = 512;     // Baldes visitados pela BFS antes de desistir
+    static constexpr unsigned PROFUNDIDADE_MAXIMA = 5; // Deslocamentos por inserção, no máximo
+    // Remoções que deixam a ocupação abaixo de 1/4 do máximo reduzem a tabela à metade.
+    static constexpr float FRACAO_ENCOLHIMENTO = 0.25f;
+
+private:
+    struct Balde {
+        uint8_t ocupados = 0; // Bit i ligado = posição i ocupada
+        size_t hashes[POSICOES_POR_BALDE] = {};
+        Key chaves[POSICOES_POR_BALDE];
+        Value valores[POSICOES_POR_BALDE];
+
+        bool ocupado(unsigned i) const { return (ocupados >> i) & 1u; }
+        int vaga() const {
+            for (unsigned i = 0; i < POSICOES_POR_BALDE; ++i)
+                if (!ocupado(i)) return static_cast<int>(i);
+            return -1;
+        }
+    };
+
+    struct ItemEstoque {
+        size_t hash;
+        Key chave;
+        Value valor;
+    };
+
+    // Nó da BFS: o balde e de onde veio (qual posição do balde pai seria movida para cá).
+    struct NoBusca {
+        size_t balde;
+        int pai;
+        unsigned posicao_no_pai;
+        unsigned profundidade;
+    };
+
+    std::vector<Balde> m_baldes;
+    size_t m_mascara = 0; // número de baldes - 1 (potência de dois)
+    std::vector<ItemEstoque> m_estoque;
+    size_t m_number_of_elements = 0;
+    float m_max_load_factor;
+    Hash m_hashing;
+
+    Stats m_stats;         // comparações e deslocamentos
+    Stats m_stats_rehash;  // rehashes (só a reestruturação é usada: a de m_stats já conta os deslocamentos)
+
+    // Mistura final do splitmix64: os 64 bits resultantes dão os dois baldes independentes.
+    static size_t misturar(size_t x) {
+        uint64_t z = static_cast<uint64_t>(x);
+        z ^= z >> 30;
+        z *= 0xbf58476d1ce4e5b9ULL;
+        z ^= z >> 27;
+        z *= 0x94d049bb133111ebULL;
+        z ^= z >> 31;
+        return static_cast<size_t>(z);
+    }
+
+    size_t balde1(size_t h) const { return h & m_mascara; }
+    size_t balde2(size_t h) const {
+        size_t b = (static_cast<uint64_t>(h) >> 32) & m_mascara;
+        return b == balde1(h) ? (b ^ 1) : b; // Os dois baldes são sempre diferentes
+    }
+    size_t alternativo(size_t h, size_t balde) const { return balde == balde1(h) ? balde2(h) : balde1(h); }
+
+    static size_t baldes_para(size_t slots) {
+        size_t baldes = 2;
+        while (baldes * POSICOES_POR_BALDE < slots) baldes <<= 1;
+        return baldes;
+    }
+
+    // Procura a chave num balde; retorna a posição ou -1.
+    int procurar_no_balde(const Balde& b, const Key& k, size_t h) const {
+        for (unsigned i = 0; i < POSICOES_POR_BALDE; ++i) {
+            if (!b.ocupado(i)) continue;
+            m_stats.comparacao();
+            if (b.hashes[i] == h && b.chaves[i] == k) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    // Localiza a chave: (balde, posição), ou balde == número de baldes e posição = índice no estoque.
+    bool localizar(const Key& k, size_t h, size_t& balde, int& posicao) const {
+        balde = balde1(h);
+        if ((posicao = procurar_no_balde(m_baldes[balde], k, h)) >= 0) return true;
+        balde = balde2(h);
+        if ((posicao = procurar_no_balde(m_baldes[balde], k, h)) >= 0) return true;
+        balde = m_baldes.size();
+        for (size_t i = 0; i < m_estoque.size(); ++i) {
+            m_stats.comparacao();
+            if (m_estoque[i].hash == h && m_estoque[i].chave == k) {
+                posicao = static_cast<int>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void gravar(size_t balde, unsigned posicao, size_t h, Key k, Value v) {
+        Balde& b = m_baldes[balde];
+        b.hashes[posicao] = h;
+        b.chaves[posicao] = std::move(k);
+        b.valores[posicao] = std::move(v);
+        b.ocupados |= static_cast<uint8_t>(1u << posicao);
+    }
+
+    // Verifica se 'balde' já aparece no caminho da BFS até o nó 'indice' (evita ciclos no caminho).
+    static bool no_caminho(const std::vector<NoBusca>& fila, int indice, size_t balde) {
+        for (; indice >= 0; indice = fila[indice].pai)
+            if (fila[indice].balde == balde) return true;
+        return false;
+    }
+
+    // Busca em largura por um caminho de deslocamentos que libere uma posição em balde1(h) ou
+    // balde2(h). Se encontrar, executa os deslocamentos e retorna o balde/posição liberados.
+    bool abrir_vaga(size_t h, size_t& balde_livre, unsigned& posicao_livre) {
+        std::vector<NoBusca> fila;
+        fila.reserve(LIMITE_BUSCA);
+        fila.push_back({balde1(h), -1, 0, 0});
+        fila.push_back({balde2(h), -1, 0, 0});
+
+        for (size_t i = 0; i < fila.size(); ++i) {
+            const NoBusca no = fila[i];
+            int vaga = m_baldes[no.balde].vaga();
+            if (vaga >= 0) {
+                // Move os elementos do fim do caminho para o começo: cada um vai para o balde filho.
+                size_t destino = no.balde;
+                unsigned posicao_destino = static_cast<unsigned>(vaga);
+                for (int atual = static_cast<int>(i); fila[atual].pai >= 0; atual = fila[atual].pai) {
+                    size_t origem = fila[fila[atual].pai].balde;
+                    unsigned posicao_origem = fila[atual].posicao_no_pai;
+                    Balde& b = m_baldes[origem];
+                    gravar(destino, posicao_destino, b.hashes[posicao_origem],
+                           std::move(b.chaves[posicao_origem]), std::move(b.valores[posicao_origem]));
+                    b.ocupados &= static_cast<uint8_t>(~(1u << posicao_origem));
+                    m_stats.reestruturacao(); // um deslocamento
+                    destino = origem;
+                    posicao_destino = posicao_origem;
+                }
+                balde_livre = destino;
+                posicao_livre = posicao_destino;
+                return true;
+            }
+            if (no.profundidade >= PROFUNDIDADE_MAXIMA) continue;
+            for (unsigned p = 0; p < POSICOES_POR_BALDE && fila.size() < LIMITE_BUSCA; ++p) {
+                size_t alt = alternativo(m_baldes[no.balde].hashes[p], no.balde);
+                if (no_caminho(fila, static_cast<int>(i), alt)) continue;
+                fila.push_back({alt, static_cast<int>(i), p, no.profundidade + 1});
+            }
+        }
+        return false;
+    }
+
+    // Coloca uma chave que sabidamente não está na tabela. Retorna false se não couber
+    // (sem caminho de deslocamento e estoque cheio).
+    bool colocar(size_t h, const Key& k, const Value& v) {
+        size_t b1 = balde1(h), b2 = balde2(h);
+        int vaga = m_baldes[b1].vaga();
+        if (vaga >= 0) { gravar(b1, static_cast<unsigned>(vaga), h, k, v); return true; }
+        vaga = m_baldes[b2].vaga();
+        if (vaga >= 0) { gravar(b2, static_cast<unsigned>(vaga), h, k, v); return true; }
+
+        size_t balde;
+        unsigned posicao;
+        if (abrir_vaga(h, balde, posicao)) {
+            gravar(balde, posicao, h, k, v);
+            return true;
+        }
+        if (m_estoque.size() < ESTOQUE_MAXIMO) {
+            m_estoque.push_back({h, k, v});
+            return true;
+        }
+        return false;
+    }
+
+    // Reconstrói a tabela com 'baldes' baldes, dobrando de novo se algum elemento não couber.
+    void reconstruir(size_t baldes) {
+        std::vector<Balde> antigos = std::move(m_baldes);
+        std::vector<ItemEstoque> estoque_antigo = std::move(m_estoque);
+        while (true) {
+            m_baldes.assign(baldes, Balde());
+            m_mascara = baldes - 1;
+            m_estoque.clear();
+            bool coube = true;
+            for (const Balde& b : antigos) {
+                for (unsigned p = 0; p < POSICOES_POR_BALDE && coube; ++p)
+                    if (b.ocupado(p)) coube = colocar(b.hashes[p], b.chaves[p], b.valores[p]);
+                if (!coube) break;
+            }
+            for (size_t i = 0; i < estoque_antigo.size() && coube; ++i)
+                coube = colocar(estoque_antigo[i].hash, estoque_antigo[i].chave, estoque_antigo[i].valor);
+            if (coube) return;
+            baldes *= 2;
+        }
+    }
+
+public:
+    // 'tableSize' é o número inicial de posições (arredondado para baldes em potência de dois).
+    HashCuckoo(size_t tableSize = 19, float load_factor = 0.95f)
+        : m_max_load_factor((load_factor <= 0 || load_factor > 1) ? 0.95f : load_factor) {
+        size_t baldes = baldes_para(tableSize);
+        m_baldes.resize(baldes);
+        m_mascara = baldes - 1;
+    }
+
+    size_t size() const { return m_number_of_elements; }
+    bool empty() const { return m_number_of_elements == 0; }
+    size_t bucket_count() const { return m_baldes.size() * POSICOES_POR_BALDE; }
+    float load_factor() const { return static_cast<float>(m_number_of_elements) / bucket_count(); }
+    float max_load_factor() const { return m_max_load_factor; }
+    size_t stash_size() const { return m_estoque.size(); }
+
+    void clear() {
+        m_baldes.assign(m_baldes.size(), Balde());
+        m_estoque.clear();
+        m_number_of_elements = 0;
+        m_stats.resetComparacoes();
+        m_stats.resetReestruturacoes();
+        m_stats_rehash.resetReestruturacoes();
+    }
+
+    // Insere a chave ou atualiza o valor se ela já existe.
+    void insert(const Key& k, const Value& v) {
+        size_t h = misturar(m_hashing(k));
+        size_t balde;
+        int posicao;
+        if (localizar(k, h, balde, posicao)) {
+            if (balde == m_baldes.size()) m_estoque[posicao].valor = v;
+            else m_baldes[balde].valores[posicao] = v;
+            return;
+        }
+        if (static_cast<float>(m_number_of_elements + 1) > m_max_load_factor * bucket_count())
+            rehash(2 * bucket_count());
+        while (!colocar(h, k, v))
+            rehash(2 * bucket_count());
+        ++m_number_of_elements;
+    }
+
+    bool remove(const Key& k) {
+        size_t h = misturar(m_hashing(k));
+        size_t balde;
+        int posicao;
+        if (!localizar(k, h, balde, posicao)) return false;
+        if (balde == m_baldes.size()) {
+            m_estoque.erase(m_estoque.begin() + posicao);
+        } else {
+            Balde& b = m_baldes[balde];
+            b.ocupados &= static_cast<uint8_t>(~(1u << posicao));
+            b.chaves[posicao] = Key();
+            b.valores[posicao] = Value();
+        }
+        --m_number_of_elements;
+        if (m_baldes.size() > 2 && load_factor() < FRACAO_ENCOLHIMENTO * m_max_load_factor)
+            rehash(bucket_count() / 2);
+        return true;
+    }
+
+    bool contains(const Key& k) const {
+        size_t balde;
+        int posicao;
+        return localizar(k, misturar(m_hashing(k)), balde, posicao);
+    }
+
+    // Valor associado à chave ou Value() se ela não existir.
+    Value count(const Key& k) const {
+        size_t balde;
+        int posicao;
+        if (!localizar(k, misturar(m_hashing(k)), balde, posicao)) return Value();
+        return balde == m_baldes.size() ? m_estoque[posicao].valor : m_baldes[balde].valores[posicao];
+    }
+
+    Value& at(const Key& k) {
+        size_t balde;
+        int posicao;
+        if (!localizar(k, misturar(m_hashing(k)), balde, posicao)) throw std::out_of_range("Chave não encontrada");
+        return balde == m_baldes.size() ? m_estoque[posicao].valor : m_baldes[balde].valores[posicao];
+    }
+
+    const Value& at(const Key& k) const {
+        size_t balde;
+        int posicao;
+        if (!localizar(k, misturar(m_hashing(k)), balde, posicao)) throw std::out_of_range("Chave não encontrada");
+        return balde == m_baldes.size() ? m_estoque[posicao].valor : m_baldes[balde].valores[posicao];
+    }
+
+    // Redimensiona para comportar 'new_size' posições (os hashes guardados são reaproveitados).
+    // Pode encolher, mas não abaixo do necessário para o fator de carga máximo.
+    void rehash(size_t new_size) {
+        new_size = std::max(new_size, static_cast<size_t>(m_number_of_elements / m_max_load_factor) + 1);
+        size_t baldes = baldes_para(new_size);
+        if (baldes == m_baldes.size()) return;
+        m_stats_rehash.reestruturacao();
+        reconstruir(baldes);
+    }
+
+    // Garante espaço para 'n' elementos sem rehash durante as inserções.
+    // Com a tabela vazia só realoca os baldes (não conta como rehash).
+    void reserve(size_t n) {
+        size_t baldes = baldes_para(static_cast<size_t>(n / m_max_load_factor) + 1);
+        if (baldes <= m_baldes.size()) return;
+        if (m_number_of_elements == 0) {
+            m_baldes.assign(baldes, Balde());
+            m_mascara = baldes - 1;
+        } else {
+            m_stats_rehash.reestruturacao();
+            reconstruir(baldes);
+        }
+    }
+
+    // Reduz a tabela ao menor número de baldes que comporta os elementos atuais.
+    void shrink_to_fit() {
+        rehash(0); // o rehash eleva para o mínimo exigido pelo fator de carga
+        m_estoque.shrink_to_fit();
+    }
+
+    void getAllPairs(std::vector<std::pair<Key, Value>>& out) const {
+        out.clear();
+        out.reserve(m_number_of_elements);
+        for (const Balde& b : m_baldes)
+            for (unsigned p = 0; p < POSICOES_POR_BALDE; ++p)
+                if (b.ocupado(p)) out.emplace_back(b.chaves[p], b.valores[p]);
+        for (const auto& item : m_estoque) out.emplace_back(item.chave, item.valor);
+    }
+
+    // Sondagens medidas em posições ocupadas examinadas, na ordem da busca (balde 1, balde 2, estoque).
+    // "Deslocamento" aqui é onde a chave está: 0 = balde 1, 1 = balde 2, 2 = estoque.
+    // A busca sem sucesso examina os dois baldes de uma chave e o estoque; para o histograma,
+    // cada balde é pareado com um segundo balde escolhido pelo mesmo misturador das chaves.
+    EstatisticasHash estatisticas() const {
+        EstatisticasHash e;
+        e.enderecamento_aberto = true;
+        e.buckets = bucket_count();
+        e.elementos = m_number_of_elements;
+        auto ocupacao = [](const Balde& b) { return static_cast<size_t>(__builtin_popcount(b.ocupados)); };
+
+        for (size_t j = 0; j < m_baldes.size(); ++j) {
+            const Balde& b = m_baldes[j];
+            size_t antes = 0;
+            for (unsigned p = 0; p < POSICOES_POR_BALDE; ++p) {
+                if (!b.ocupado(p)) continue;
+                ++antes;
+                size_t h = b.hashes[p];
+                if (j == balde1(h)) {
+                    EstatisticasHash::registrar(e.sondagem_sucesso, antes);
+                } else {
+                    if (e.deslocamento_maximo < 1) e.deslocamento_maximo = 1;
+                    EstatisticasHash::registrar(e.sondagem_sucesso, ocupacao(m_baldes[balde1(h)]) + antes);
+                }
+            }
+            size_t par = balde2(misturar(j));
+            EstatisticasHash::registrar(e.sondagem_falha, ocupacao(b) + ocupacao(m_baldes[par]) + m_estoque.size());
+        }
+        for (size_t i = 0; i < m_estoque.size(); ++i) {
+            e.deslocamento_maximo = 2;
+            size_t h = m_estoque[i].hash;
+            EstatisticasHash::registrar(e.sondagem_sucesso,
+                                        ocupacao(m_baldes[balde1(h)]) + ocupacao(m_baldes[balde2(h)]) + i + 1);
+        }
+        return e;
+    }
+
+    void show() const {
+        std::cout << "Balde\tPosicao\tChave\tValor\n";
+        for (size_t j = 0; j < m_baldes.size(); ++j)
+            for (unsigned p = 0; p < POSICOES_POR_BALDE; ++p)
+                if (m_baldes[j].ocupado(p))
+                    std::cout << j << "\t" << p << "\t" << m_baldes[j].chaves[p] << "\t" << m_baldes[j].valores[p] << "\n";
+        for (const auto& item : m_estoque)
+            std::cout << "estoque\t-\t" << item.chave << "\t" << item.valor << "\n";
+    }
+
+    // Getters para estatísticas
+    size_t getComparacoesPrincipais() const { return m_stats.comparacoes(); }
+    size_t getDeslocamentos() const { return m_stats.reestruturacoes(); }
+    size_t getRehashes() const { return m_stats_rehash.reestruturacoes(); }
+    void resetComparacoes() { m_stats.resetComparacoes(); }
+    void resetDeslocamentos() { m_stats.resetReestruturacoes(); }
+    void resetRehash() { m_stats_rehash.resetReestruturacoes(); }
+};
+
+#endif // HASH_CUCKOO_HPP
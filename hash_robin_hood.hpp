@@ -0,0 +1,277 @@
+#ifndef HASH_ROBIN_HOOD_HPP
+#define HASH_ROBIN_HOOD_HPP
+
+#include <vector>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <cstdint>
+#include <iostream>
+#include "estatisticas_hash.hpp"
+#include "politica_estatisticas.hpp"
+
+// Tabela hash de endereçamento aberto com Robin Hood hashing.
+// Cada slot guarda a distância da chave até o seu slot ideal. Na inserção, quem está mais longe
+// de casa fica com o slot ("rouba dos ricos"), o que mantém as distâncias curtas e parecidas
+// mesmo com fator de carga 0.9.
+// - Busca sem sucesso termina cedo: ao achar um slot cuja distância é menor que a percorrida,
+//   a chave não pode estar mais adiante.
+// - Remoção por deslocamento para trás (backward shift): os elementos seguintes voltam uma posição,
+//   então não existem marcas de REMOVIDO e as sondagens não pioram depois de remoções.
+// - Tamanho potência de dois; o slot ideal vem dos bits altos de hash * constante de Fibonacci.
+// - O hash de cada chave fica guardado: o rehash não recalcula hashes e a maioria das
+//   comparações de chaves diferentes é resolvida comparando os hashes.
+// 'Stats' escolhe a instrumentação: CountingStats (comparações e rehashes) ou NullStats (nenhuma).
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Stats = CountingStats>
+class HashRobinHood {
+private:
+    struct Slot {
+        uint32_t distancia = 0; // 0 = vazio; d > 0 = chave a d - 1 posições do slot ideal
+        size_t hash = 0;
+        Key chave{};
+        Value valor{};
+    };
+
+    std::vector<Slot> m_table;
+    size_t m_table_size;
+    size_t m_mascara;           // m_table_size - 1
+    unsigned m_deslocamento;    // 64 - log2(m_table_size), para extrair os bits altos
+    size_t m_number_of_elements = 0;
+    float m_max_load_factor;
+    Hash m_hashing;
+
+    Stats m_stats; // comparações (slots ocupados examinados) e rehashes
+
+    // Remoções que deixam o fator de carga abaixo de 1/4 do máximo reduzem a tabela à metade
+    // (a carga fica na metade do máximo), nunca abaixo do tamanho mínimo.
+    static constexpr float FRACAO_ENCOLHIMENTO = 0.25f;
+    static constexpr size_t TAMANHO_MINIMO = 8;
+
+    // Menor potência de dois com que 'n' elementos ficam dentro do fator de carga máximo.
+    size_t minimo_para(size_t n) const {
+        return proxima_potencia_de_dois(static_cast<size_t>(n / m_max_load_factor) + 1);
+    }
+
+    static size_t proxima_potencia_de_dois(size_t x) {
+        size_t p = 8;
+        while (p < x) p <<= 1;
+        return p;
+    }
+
+    void configurar_tamanho(size_t tamanho) {
+        m_table_size = tamanho;
+        m_mascara = tamanho - 1;
+        unsigned bits = 0;
+        while ((size_t(1) << bits) < tamanho) ++bits;
+        m_deslocamento = 64 - bits;
+    }
+
+    // Slot ideal: hashing de Fibonacci (espalha bem mesmo hashes fracos, como o de inteiros).
+    size_t slot_ideal(size_t h) const {
+        return static_cast<size_t>((static_cast<uint64_t>(h) * 11400714819323198485ULL) >> m_deslocamento);
+    }
+
+    // Retorna o índice da chave ou m_table_size se não estiver na tabela.
+    size_t buscar(const Key& k, size_t h) const {
+        size_t pos = slot_ideal(h);
+        for (uint32_t dist = 1; ; ++dist) {
+            const Slot& slot = m_table[pos];
+            // Vazio ou mais "rico" que nós: a chave não está na tabela.
+            if (slot.distancia < dist) return m_table_size;
+            m_stats.comparacao(); // slot ocupado examinado
+            if (slot.hash == h && slot.chave == k) return pos;
+            pos = (pos + 1) & m_mascara;
+        }
+    }
+
+    // Coloca um elemento que sabidamente não está na tabela, a partir de 'pos' (novo.distancia já
+    // corresponde a essa posição), trocando de lugar com os elementos mais próximos de casa.
+    void colocar(Slot novo, size_t pos) {
+        while (true) {
+            Slot& slot = m_table[pos];
+            if (slot.distancia == 0) {
+                slot = std::move(novo);
+                return;
+            }
+            if (slot.distancia < novo.distancia) std::swap(slot, novo);
+            pos = (pos + 1) & m_mascara;
+            novo.distancia++;
+        }
+    }
+
+public:
+    // 'tableSize' é arredondado para a próxima potência de dois (mínimo 8).
+    HashRobinHood(size_t tableSize = 19, float load_factor = 0.9f)
+        : m_max_load_factor((load_factor <= 0 || load_factor >= 1) ? 0.9f : load_factor) {
+        configurar_tamanho(proxima_potencia_de_dois(tableSize));
+        m_table.resize(m_table_size);
+    }
+
+    size_t size() const { return m_number_of_elements; }
+    bool empty() const { return m_number_of_elements == 0; }
+    size_t bucket_count() const { return m_table_size; }
+    float load_factor() const { return static_cast<float>(m_number_of_elements) / m_table_size; }
+    float max_load_factor() const { return m_max_load_factor; }
+
+    void clear() {
+        m_table.assign(m_table_size, Slot());
+        m_number_of_elements = 0;
+        m_stats.resetComparacoes();
+        m_stats.resetReestruturacoes();
+    }
+
+    // Insere a chave ou atualiza o valor se ela já existe.
+    void insert(const Key& k, const Value& v) {
+        if (static_cast<float>(m_number_of_elements + 1) > m_max_load_factor * m_table_size)
+            rehash(m_table_size * 2);
+
+        size_t h = m_hashing(k);
+        size_t pos = slot_ideal(h);
+        uint32_t dist = 1;
+        // Procura a chave; para no primeiro slot onde ela estaria se existisse.
+        while (m_table[pos].distancia >= dist) {
+            m_stats.comparacao();
+            if (m_table[pos].hash == h && m_table[pos].chave == k) {
+                m_table[pos].valor = v;
+                return;
+            }
+            pos = (pos + 1) & m_mascara;
+            ++dist;
+        }
+
+        Slot novo;
+        novo.distancia = dist;
+        novo.hash = h;
+        novo.chave = k;
+        novo.valor = v;
+        colocar(std::move(novo), pos);
+        ++m_number_of_elements;
+    }
+
+    // Remove a chave deslocando os elementos seguintes uma posição para trás.
+    bool remove(const Key& k) {
+        size_t pos = buscar(k, m_hashing(k));
+        if (pos == m_table_size) return false;
+
+        size_t proximo = (pos + 1) & m_mascara;
+        while (m_table[proximo].distancia > 1) {
+            m_table[pos] = std::move(m_table[proximo]);
+            m_table[pos].distancia--;
+            pos = proximo;
+            proximo = (proximo + 1) & m_mascara;
+        }
+        m_table[pos] = Slot();
+        --m_number_of_elements;
+        if (m_table_size > TAMANHO_MINIMO && load_factor() < FRACAO_ENCOLHIMENTO * m_max_load_factor)
+            rehash(m_table_size / 2);
+        return true;
+    }
+
+    bool contains(const Key& k) const {
+        return buscar(k, m_hashing(k)) != m_table_size;
+    }
+
+    // Valor associado à chave ou Value() se ela não existir.
+    Value count(const Key& k) const {
+        size_t pos = buscar(k, m_hashing(k));
+        return pos == m_table_size ? Value() : m_table[pos].valor;
+    }
+
+    Value& at(const Key& k) {
+        size_t pos = buscar(k, m_hashing(k));
+        if (pos == m_table_size) throw std::out_of_range("Chave não encontrada");
+        return m_table[pos].valor;
+    }
+
+    const Value& at(const Key& k) const {
+        size_t pos = buscar(k, m_hashing(k));
+        if (pos == m_table_size) throw std::out_of_range("Chave não encontrada");
+        return m_table[pos].valor;
+    }
+
+    // Redimensiona para a potência de dois >= new_size (sem recalcular hashes).
+    void rehash(size_t new_size) {
+        size_t tamanho = proxima_potencia_de_dois(new_size);
+        if (tamanho == m_table_size || m_number_of_elements > m_max_load_factor * tamanho) return;
+        m_stats.reestruturacao(); // conta rehash
+        std::vector<Slot> old_table = std::move(m_table);
+        configurar_tamanho(tamanho);
+        m_table.clear();
+        m_table.resize(m_table_size);
+        for (auto& slot : old_table) {
+            if (slot.distancia == 0) continue;
+            slot.distancia = 1;
+            size_t pos = slot_ideal(slot.hash);
+            colocar(std::move(slot), pos);
+        }
+    }
+
+    // Garante espaço para 'n' elementos sem rehash durante as inserções.
+    // Com a tabela vazia só realoca os slots (não conta como rehash).
+    void reserve(size_t n) {
+        size_t tamanho = minimo_para(n);
+        if (tamanho <= m_table_size) return;
+        if (m_number_of_elements == 0) {
+            configurar_tamanho(tamanho);
+            m_table.assign(m_table_size, Slot());
+        } else {
+            rehash(tamanho);
+        }
+    }
+
+    // Reduz a tabela à menor potência de dois que comporta os elementos atuais.
+    // Não há marcas de remoção para limpar (a remoção desloca os elementos para trás).
+    void shrink_to_fit() {
+        rehash(minimo_para(m_number_of_elements));
+    }
+
+    // Coleta todos os pares (chave, valor).
+    void getAllPairs(std::vector<std::pair<Key, Value>>& out) const {
+        out.clear();
+        out.reserve(m_number_of_elements);
+        for (const auto& slot : m_table)
+            if (slot.distancia) out.emplace_back(slot.chave, slot.valor);
+    }
+
+    // Distribuição das sondagens. Sucesso: distância armazenada. Falha: slots examinados a partir
+    // de cada posição até a parada antecipada (slot vazio ou com distância menor que a percorrida).
+    EstatisticasHash estatisticas() const {
+        EstatisticasHash e;
+        e.enderecamento_aberto = true;
+        e.buckets = m_table_size;
+        e.elementos = m_number_of_elements;
+        for (size_t j = 0; j < m_table_size; ++j) {
+            const Slot& slot = m_table[j];
+            if (slot.distancia) {
+                if (slot.distancia - 1 > e.deslocamento_maximo) e.deslocamento_maximo = slot.distancia - 1;
+                EstatisticasHash::registrar(e.sondagem_sucesso, slot.distancia);
+            }
+            size_t examinados = 0;
+            size_t pos = j;
+            while (examinados < m_table_size && m_table[pos].distancia > examinados) {
+                ++examinados;
+                pos = (pos + 1) & m_mascara;
+            }
+            EstatisticasHash::registrar(e.sondagem_falha, examinados);
+        }
+        return e;
+    }
+
+    void show() const {
+        std::cout << "Indice\tDistancia\tChave\tValor\n";
+        for (size_t i = 0; i < m_table_size; ++i) {
+            std::cout << i << "\t";
+            if (m_table[i].distancia == 0) std::cout << "VAZIO";
+            else std::cout << m_table[i].distancia - 1 << "\t" << m_table[i].chave << "\t" << m_table[i].valor;
+            std::cout << "\n";
+        }
+    }
+
+    // Getters para estatísticas
+    size_t getComparacoesPrincipais() const { return m_stats.comparacoes(); }
+    size_t getRehashes() const { return m_stats.reestruturacoes(); }
+    void resetComparacoes() { m_stats.resetComparacoes(); }
+    void resetRehash() { m_stats.resetReestruturacoes(); }
+};
+
+#endif // HASH_ROBIN_HOOD_HPP
@@ -0,0 +1,152 @@
+#ifndef HYPERLOGLOG_HPP
+#define HYPERLOGLOG_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+// HyperLogLog: estimativa do número de chaves distintas com memória O(2^p) bytes.
+// O erro padrão relativo é ~1.04 / sqrt(2^p) (p = 14 -> ~0.8%).
+// - Representação esparsa: enquanto poucos registradores estão ocupados, guarda apenas pares
+//   (índice, posto) codificados em 32 bits, ordenados e sem repetição.
+// - Representação densa: um byte por registrador; adotada quando a esparsa passaria a ocupar
+//   mais memória que ela.
+// - Sketches com a mesma precisão podem ser mesclados (merge), permitindo que cada thread
+//   conte uma parte da entrada e o resultado seja combinado no fim.
+template <typename Key, typename Hash = std::hash<Key>>
+class HyperLogLog {
+private:
+    unsigned m_precisao;             // p: bits do hash usados como índice do registrador
+    size_t m_registros;              // m = 2^p
+    bool m_esparso = true;
+    std::vector<uint32_t> m_esparsos; // (índice << 8) | posto, ordenado por índice, um por índice
+    std::vector<uint32_t> m_pendentes; // Inserções esparsas ainda não incorporadas (buffer)
+    std::vector<uint8_t> m_densos;   // Um registrador por posição (só na forma densa)
+    Hash m_hashing;
+
+    // Mistura final do splitmix64: garante bits altos bem distribuídos para o índice.
+    static uint64_t misturar(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    static uint32_t indiceDe(uint32_t codigo) { return codigo >> 8; }
+    static uint8_t postoDe(uint32_t codigo) { return static_cast<uint8_t>(codigo & 0xFF); }
+
+    // Limite de entradas esparsas antes de converter para a forma densa (4 bytes por entrada).
+    size_t limiteEsparso() const { return m_registros / 4; }
+
+    // Ordena o buffer pendente e incorpora à lista esparsa, mantendo o maior posto por índice.
+    void incorporarPendentes() {
+        if (m_pendentes.empty()) return;
+        std::vector<uint32_t> todos;
+        todos.reserve(m_esparsos.size() + m_pendentes.size());
+        todos.insert(todos.end(), m_esparsos.begin(), m_esparsos.end());
+        todos.insert(todos.end(), m_pendentes.begin(), m_pendentes.end());
+        m_pendentes.clear();
+        std::sort(todos.begin(), todos.end());
+        // Com a codificação (índice << 8) | posto, o último de cada índice tem o maior posto.
+        m_esparsos.clear();
+        for (size_t i = 0; i < todos.size(); ++i) {
+            if (i + 1 < todos.size() && indiceDe(todos[i + 1]) == indiceDe(todos[i])) continue;
+            m_esparsos.push_back(todos[i]);
+        }
+        if (m_esparsos.size() > limiteEsparso()) converterParaDenso();
+    }
+
+    void converterParaDenso() {
+        m_densos.assign(m_registros, 0);
+        for (uint32_t codigo : m_esparsos)
+            m_densos[indiceDe(codigo)] = std::max(m_densos[indiceDe(codigo)], postoDe(codigo));
+        for (uint32_t codigo : m_pendentes)
+            m_densos[indiceDe(codigo)] = std::max(m_densos[indiceDe(codigo)], postoDe(codigo));
+        m_esparsos.clear();
+        m_esparsos.shrink_to_fit();
+        m_pendentes.clear();
+        m_pendentes.shrink_to_fit();
+        m_esparso = false;
+    }
+
+    void registrar(uint32_t indice, uint8_t posto) {
+        if (m_esparso) {
+            m_pendentes.push_back((indice << 8) | posto);
+            if (m_pendentes.size() >= std::max<size_t>(limiteEsparso() / 4, 16)) incorporarPendentes();
+        } else if (posto > m_densos[indice]) {
+            m_densos[indice] = posto;
+        }
+    }
+
+public:
+    // 'precisao' entre 4 e 18; 14 usa 16 KiB na forma densa.
+    explicit HyperLogLog(unsigned precisao = 14) {
+        if (precisao < 4 || precisao > 18) throw std::invalid_argument("Precisao do HyperLogLog deve estar entre 4 e 18");
+        m_precisao = precisao;
+        m_registros = size_t(1) << precisao;
+    }
+
+    // Registra uma ocorrência de 'key'.
+    void add(const Key& key) {
+        uint64_t h = misturar(static_cast<uint64_t>(m_hashing(key)));
+        uint32_t indice = static_cast<uint32_t>(h >> (64 - m_precisao));
+        uint64_t resto = h << m_precisao;
+        // Posto = posição do primeiro bit 1 no restante do hash (limitado a 64 - p + 1).
+        unsigned posto = resto ? static_cast<unsigned>(__builtin_clzll(resto)) + 1 : 64 - m_precisao + 1;
+        registrar(indice, static_cast<uint8_t>(std::min(posto, 64 - m_precisao + 1)));
+    }
+
+    // Combina outro sketch (da mesma precisão) neste: o resultado estima a união dos conjuntos.
+    void merge(const HyperLogLog& outro) {
+        if (outro.m_precisao != m_precisao) throw std::invalid_argument("HyperLogLog com precisoes diferentes");
+        if (outro.m_esparso) {
+            for (uint32_t codigo : outro.m_esparsos) registrar(indiceDe(codigo), postoDe(codigo));
+            for (uint32_t codigo : outro.m_pendentes) registrar(indiceDe(codigo), postoDe(codigo));
+            return;
+        }
+        if (m_esparso) converterParaDenso();
+        for (size_t i = 0; i < m_registros; ++i)
+            m_densos[i] = std::max(m_densos[i], outro.m_densos[i]);
+    }
+
+    // Retorna a estimativa do número de chaves distintas.
+    double estimate() {
+        incorporarPendentes();
+        double soma = 0.0;
+        size_t zeros = 0;
+        if (m_esparso) {
+            zeros = m_registros - m_esparsos.size();
+            soma = static_cast<double>(zeros);
+            for (uint32_t codigo : m_esparsos) soma += std::ldexp(1.0, -postoDe(codigo));
+        } else {
+            for (uint8_t r : m_densos) {
+                soma += std::ldexp(1.0, -r);
+                if (r == 0) zeros++;
+            }
+        }
+
+        double m = static_cast<double>(m_registros);
+        double alfa = (m_registros == 16) ? 0.673 : (m_registros == 32) ? 0.697 : (m_registros == 64) ? 0.709
+                    : 0.7213 / (1.0 + 1.079 / m);
+        double estimativa = alfa * m * m / soma;
+        // Correção para cardinalidades pequenas: contagem linear sobre os registradores vazios.
+        if (estimativa <= 2.5 * m && zeros > 0)
+            estimativa = m * std::log(m / static_cast<double>(zeros));
+        return estimativa;
+    }
+
+    unsigned precisao() const { return m_precisao; }
+    bool esparso() const { return m_esparso; }
+    // Erro padrão relativo teórico (1.04 / sqrt(m)).
+    double erroPadrao() const { return 1.04 / std::sqrt(static_cast<double>(m_registros)); }
+    size_t memoriaBytes() const {
+        return m_esparso ? (m_esparsos.capacity() + m_pendentes.capacity()) * sizeof(uint32_t) : m_densos.size();
+    }
+};
+
+#endif // HYPERLOGLOG_HPP
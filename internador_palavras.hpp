@@ -0,0 +1,42 @@
+#ifndef INTERNADOR_PALAVRAS_HPP
+#define INTERNADOR_PALAVRAS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// Tabela de internação: dá a cada palavra distinta um id denso de 32 bits (0, 1, 2, ... na ordem
+// da primeira ocorrência) e guarda o caminho de volta, id → palavra.
+// A resolução palavra → id usa qualquer dicionário com a interface de contagem do CacheRecente
+// (DicionarioAvl, DicionarioRb, DicionarioChained, DicionarioOpen com Value = uint32_t): uma só
+// busca por palavra, com localizar_ou_inserir. O valor guardado é id + 1, porque 0 é o valor
+// de uma chave recém-inserida.
+template <typename Dicionario, typename Key>
+class InternadorPalavras {
+public:
+    // Id de 'palavra', criado na primeira vez que ela aparece.
+    uint32_t resolver(const Key& palavra) {
+        uint32_t& valor = Dicionario::valor(m_dicionario.localizar_ou_inserir(palavra));
+        if (valor == 0) {
+            if (m_palavras.size() == std::numeric_limits<uint32_t>::max())
+                throw std::length_error("InternadorPalavras: mais de 2^32 - 1 palavras distintas");
+            m_palavras.push_back(palavra);
+            valor = static_cast<uint32_t>(m_palavras.size());
+        }
+        return valor - 1;
+    }
+
+    const Key& palavra(uint32_t id) const { return m_palavras.at(id); }
+    size_t size() const { return m_palavras.size(); }
+
+    // Dicionário da resolução (para ler os contadores de comparações e rotações/rehashes).
+    const Dicionario& dicionario() const { return m_dicionario; }
+
+private:
+    Dicionario m_dicionario;
+    std::vector<Key> m_palavras; // id → palavra
+};
+
+#endif // INTERNADOR_PALAVRAS_HPP
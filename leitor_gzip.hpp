@@ -0,0 +1,180 @@
+#ifndef LEITOR_GZIP_HPP
+#define LEITOR_GZIP_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <zlib.h> // Ligar com -lz
+
+// Leitura de arquivos .gz sem descompactar para o disco.
+// BufferGzip é um std::streambuf: um std::istream sobre ele entrega o texto já descompactado, então
+// o laço de tokenização (getline + >>) é o mesmo dos arquivos comuns.
+// - A descompactação (zlib) roda numa thread própria, em blocos de TAMANHO_BLOCO bytes.
+// - Dois blocos se alternam: enquanto o leitor tokeniza um, a thread preenche o outro, de modo
+//   que a descompactação se sobrepõe à contagem.
+// - Membros concatenados (cat a.gz b.gz > c.gz) são lidos em sequência, como faz o gzip.
+// - Erros (arquivo truncado ou corrompido) encerram o fluxo; erro() devolve a mensagem.
+
+// Verifica os bytes mágicos do gzip (1f 8b) no início do arquivo.
+inline bool eh_gzip(const std::string& caminho) {
+    std::ifstream arquivo(caminho, std::ios::binary);
+    unsigned char magico[2] = {0, 0};
+    arquivo.read(reinterpret_cast<char*>(magico), 2);
+    return arquivo.gcount() == 2 && magico[0] == 0x1f && magico[1] == 0x8b;
+}
+
+// Tamanho descompactado registrado no fim de um .gz (campo ISIZE, 4 bytes little-endian).
+// É o tamanho módulo 2^32 do último membro: exato para arquivos de um membro com menos de 4 GiB,
+// só uma indicação nos demais. Retorna -1 se o arquivo não puder ser lido.
+inline std::streamoff tamanho_descompactado(const std::string& caminho) {
+    std::ifstream arquivo(caminho, std::ios::binary | std::ios::ate);
+    if (!arquivo.is_open() || arquivo.tellg() < 18) return -1;
+    arquivo.seekg(-4, std::ios::end);
+    unsigned char isize[4];
+    arquivo.read(reinterpret_cast<char*>(isize), 4);
+    if (arquivo.gcount() != 4) return -1;
+    return static_cast<std::streamoff>(static_cast<uint32_t>(isize[0]) | static_cast<uint32_t>(isize[1]) << 8 |
+                                       static_cast<uint32_t>(isize[2]) << 16 | static_cast<uint32_t>(isize[3]) << 24);
+}
+
+class BufferGzip : public std::streambuf {
+public:
+    static constexpr size_t TAMANHO_BLOCO = 1 << 18;   // Texto descompactado por bloco (256 KiB)
+    static constexpr size_t TAMANHO_ENTRADA = 1 << 16; // Bytes compactados lidos por vez
+
+    explicit BufferGzip(const std::string& caminho) : m_arquivo(caminho, std::ios::binary) {
+        if (!m_arquivo.is_open()) return;
+        for (auto& bloco : m_blocos) bloco.resize(TAMANHO_BLOCO);
+        m_thread = std::thread(&BufferGzip::descompactar, this);
+    }
+
+    BufferGzip(const BufferGzip&) = delete;
+    BufferGzip& operator=(const BufferGzip&) = delete;
+
+    ~BufferGzip() {
+        {
+            std::lock_guard<std::mutex> trava(m_mutex);
+            m_parar = true;
+        }
+        m_condicao.notify_all();
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+    bool aberto() const { return m_thread.joinable(); }
+
+    // Mensagem do erro de descompactação (vazia se não houve erro).
+    std::string erro() const {
+        std::lock_guard<std::mutex> trava(m_mutex);
+        return m_erro;
+    }
+
+protected:
+    // Devolve o bloco atual à thread de descompactação e passa a ler o próximo.
+    int_type underflow() override {
+        if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+
+        std::unique_lock<std::mutex> trava(m_mutex);
+        if (m_consumindo >= 0) {
+            m_consumindo = -1;
+            m_condicao.notify_all();
+        }
+        m_condicao.wait(trava, [&] { return m_prontos[m_proximo] || m_fim; });
+        if (!m_prontos[m_proximo]) return traits_type::eof();
+
+        int bloco = m_proximo;
+        m_prontos[bloco] = false;
+        m_proximo = 1 - bloco;
+        if (m_tamanhos[bloco] == 0) return traits_type::eof();
+        m_consumindo = bloco;
+        char* inicio = m_blocos[bloco].data();
+        setg(inicio, inicio, inicio + m_tamanhos[bloco]);
+        return traits_type::to_int_type(*gptr());
+    }
+
+private:
+    std::ifstream m_arquivo;
+    std::vector<char> m_blocos[2];
+    size_t m_tamanhos[2] = {0, 0};
+    bool m_prontos[2] = {false, false}; // Bloco preenchido e ainda não entregue ao leitor
+    int m_consumindo = -1;              // Bloco em uso pelo leitor (-1 = nenhum)
+    int m_proximo = 0;                  // Próximo bloco a entregar ao leitor
+    bool m_fim = false;                 // A thread terminou (último bloco já marcado como pronto)
+    bool m_parar = false;               // O leitor foi destruído antes do fim
+    std::string m_erro;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condicao;
+    std::thread m_thread;
+
+    // Corpo da thread: preenche os blocos alternadamente até o fim do arquivo ou um erro.
+    void descompactar() {
+        z_stream z{};
+        std::string erro;
+        if (inflateInit2(&z, 15 + 16) != Z_OK) erro = "falha ao iniciar a zlib"; // 15 + 16: só formato gzip
+        std::vector<unsigned char> entrada(TAMANHO_ENTRADA);
+        bool membro_completo = false; // Nada descompactado desde o fim do último membro
+        bool terminou = !erro.empty();
+        int bloco = 0;
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> trava(m_mutex);
+                m_condicao.wait(trava, [&] { return m_parar || (!m_prontos[bloco] && m_consumindo != bloco); });
+                if (m_parar) break;
+            }
+
+            unsigned char* saida = reinterpret_cast<unsigned char*>(m_blocos[bloco].data());
+            size_t cheio = 0;
+            while (cheio < TAMANHO_BLOCO && !terminou) {
+                if (z.avail_in == 0) {
+                    m_arquivo.read(reinterpret_cast<char*>(entrada.data()), static_cast<std::streamsize>(entrada.size()));
+                    z.next_in = entrada.data();
+                    z.avail_in = static_cast<uInt>(m_arquivo.gcount());
+                    if (z.avail_in == 0) {
+                        if (!membro_completo) erro = "arquivo gzip truncado";
+                        terminou = true;
+                        break;
+                    }
+                }
+                z.next_out = saida + cheio;
+                z.avail_out = static_cast<uInt>(TAMANHO_BLOCO - cheio);
+                int resultado = inflate(&z, Z_NO_FLUSH);
+                size_t produzidos = (TAMANHO_BLOCO - cheio) - z.avail_out;
+                cheio += produzidos;
+                if (resultado == Z_STREAM_END) {
+                    membro_completo = true;
+                    inflateReset(&z); // Pode haver outro membro em seguida
+                } else if (resultado == Z_OK || resultado == Z_BUF_ERROR) {
+                    if (produzidos > 0) membro_completo = false;
+                } else {
+                    // Bytes que não formam um membro depois de um membro completo (ex.: zeros
+                    // de preenchimento) são ignorados, como no gzip; no meio de um membro é erro.
+                    if (!membro_completo) erro = z.msg ? z.msg : "dados gzip inválidos";
+                    terminou = true;
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> trava(m_mutex);
+                m_tamanhos[bloco] = cheio;
+                m_prontos[bloco] = true;
+                if (terminou) {
+                    m_erro = erro;
+                    m_fim = true;
+                }
+            }
+            m_condicao.notify_all();
+            if (terminou) break;
+            bloco = 1 - bloco;
+        }
+        inflateEnd(&z);
+    }
+};
+
+#endif // LEITOR_GZIP_HPP
@@ -0,0 +1,73 @@
+#ifndef LOTE_ARQUIVOS_HPP
+#define LOTE_ARQUIVOS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// Apoio ao modo lote do main_final: vários arquivos e diretórios contados de uma vez por um
+// conjunto de threads, cada uma com o seu dicionário (mesclados no fim).
+
+// Expande as entradas da linha de comando em arquivos regulares: arquivos entram como estão e
+// diretórios são percorridos recursivamente (em ordem de caminho, para a saída ser reproduzível).
+// Retorna false (e avisa em std::cerr) se alguma entrada não existir ou não puder ser lida.
+inline bool listar_arquivos(const std::vector<std::string>& entradas, std::vector<std::string>& arquivos) {
+    namespace fs = std::filesystem;
+    arquivos.clear();
+    for (const std::string& entrada : entradas) {
+        std::error_code erro;
+        fs::file_status status = fs::status(entrada, erro);
+        if (erro || !fs::exists(status)) {
+            std::cerr << "Erro ao abrir arquivo: " << entrada << std::endl;
+            return false;
+        }
+        if (!fs::is_directory(status)) {
+            arquivos.push_back(entrada);
+            continue;
+        }
+
+        std::vector<std::string> encontrados;
+        fs::recursive_directory_iterator it(entrada, fs::directory_options::skip_permission_denied, erro);
+        for (fs::recursive_directory_iterator fim; !erro && it != fim; it.increment(erro)) {
+            if (it->is_regular_file(erro)) encontrados.push_back(it->path().string());
+        }
+        if (erro) {
+            std::cerr << "Erro ao percorrer diretório: " << entrada << " (" << erro.message() << ")" << std::endl;
+            return false;
+        }
+        std::sort(encontrados.begin(), encontrados.end());
+        arquivos.insert(arquivos.end(), encontrados.begin(), encontrados.end());
+    }
+    return true;
+}
+
+// Número de threads do lote: o pedido (0 = uma por núcleo), limitado ao número de tarefas.
+inline size_t threads_do_lote(size_t pedidas, size_t num_tarefas) {
+    size_t threads = pedidas ? pedidas : std::max<unsigned>(std::thread::hardware_concurrency(), 1u);
+    return std::max<size_t>(std::min(threads, num_tarefas), 1);
+}
+
+// Executa 'tarefa(trabalhador, indice)' para cada índice em [0, num_tarefas) em 'num_trabalhadores'
+// threads. Cada thread pega o próximo índice livre ao terminar o anterior, então arquivos de
+// tamanhos muito diferentes se distribuem sozinhos. 'trabalhador' identifica a thread
+// (0 .. num_trabalhadores - 1) para que cada uma use apenas o seu próprio estado.
+template <typename Tarefa>
+void executar_em_lote(size_t num_tarefas, size_t num_trabalhadores, Tarefa&& tarefa) {
+    std::atomic<size_t> proxima{0};
+    auto trabalhar = [&](size_t trabalhador) {
+        for (size_t i = proxima++; i < num_tarefas; i = proxima++) tarefa(trabalhador, i);
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < num_trabalhadores; ++t) threads.emplace_back(trabalhar, t);
+    trabalhar(0); // A thread principal também trabalha
+    for (std::thread& thread : threads) thread.join();
+}
+
+#endif // LOTE_ARQUIVOS_HPP
@@ -7,6 +7,13 @@
 #include <vector>  
 #include <algorithm> 
 #include <functional> 
+#include <limits>
+#include <thread>
+#include <cmath>
+#include <unordered_set>
+#include <memory>
+#include <filesystem>
+#include <system_error>
 
 
 #include <unicode/unistr.h>
@@ -16,7 +23,59 @@
 #include "dicionarioavl.hpp"
 #include "dicionariochained.hpp" 
 #include "dicionarioopen.hpp"       
+#include "dicionariorobin.hpp"
+#include "dicionariocuckoo.hpp"
 #include "dicionariorb.hpp"     
+#include "dicionariosplay.hpp"
+#include "dicionarioart.hpp"
+#include "count_min_sketch.hpp"
+#include "hyperloglog.hpp"
+#include "space_saving.hpp"
+#include "candidatos_top_k.hpp"
+#include "contadores_hw.hpp"
+#include "metricas_fases.hpp"
+#include "politica_estatisticas.hpp"
+#include "chave_curta.hpp"
+#include "cache_recente.hpp"
+#include "lote_arquivos.hpp"
+#include "leitor_gzip.hpp"
+#include "buffer_tokens.hpp"
+#include "arquivo_tokens.hpp"
+#include "internador_palavras.hpp"
+
+// Opções de linha de comando repassadas às funções de processamento.
+struct OpcoesExecucao {
+    size_t largura_cms = 65536;    // --width (modo cms)
+    size_t profundidade_cms = 4;   // --depth (modo cms)
+    size_t top_k = 100;            // --top (modos cms e heavy)
+    size_t num_threads = 1;        // --threads (HyperLogLog)
+    bool pre_dimensionar = false;  // --presize (tabelas hash, estimativa HyperLogLog)
+    bool pre_dimensionar_amostra = false; // --presize-sample (tabelas hash, estimativa por amostra)
+    bool contadores_hw = false;    // --perf (contadores de hardware na fase de montagem)
+    std::string formato_stats;     // --stats-format json|csv (métricas por fase; vazio = desligado)
+    bool estatisticas_hash = false; // --hash-stats (histogramas de sondagem das tabelas hash)
+    bool estatisticas_arvore = false; // --tree-stats (forma das árvores avl, rb e splay)
+    bool sem_estatisticas = false; // --no-stats (variante NullStats, sem contadores de comparação)
+    bool chaves_curtas = false;    // --short-keys (ChaveCurta no lugar de std::string)
+    std::string ordem_cadeias = OrdemInsercao::nome; // --chain-order insertion|mtf|transpose (modo chained)
+    size_t entradas_cache = 0;     // --cache N (cache de tokens recentes em avl, rb, chained e open; 0 = desligado)
+    size_t num_trabalhadores = 0;  // --workers N (modo lote; 0 = uma thread por núcleo)
+    bool estatisticas_arquivos = false; // --per-file-stats (modo lote: palavras e tempo de cada arquivo)
+    std::string estrutura_ids = "open"; // --id-backend avl|rb|chained|open (modo ids)
+    bool entrada_tokens = false;   // --tokens (a entrada é um arquivo de tokens gerado por --dump-tokens)
+    const BufferTokens* tokens = nullptr; // Modo 'all': tokens já lidos e normalizados (não é opção de linha de comando)
+};
+
+// Resumo de uma execução, usado na tabela comparativa do modo 'all'.
+struct ResumoExecucao {
+    bool concluido = false;
+    long long duracao_ns = 0;
+    long long comparacoes = 0;
+    long long reestruturacoes = 0; // Rotações (árvores) ou rehashes (tabelas)
+    size_t distintas = 0;
+    bool contadores = false;       // false com --no-stats (NullStats)
+    bool so_desempates = false;    // Árvores: 'comparacoes' conta só os desempates além do prefixo de 8 bytes
+};
 
 // Funções Auxiliares Comuns
 
@@ -39,299 +98,1635 @@ std::string limpar_e_minusculo(const std::string& palavra) {
     return resultado;
 }
 
-// Funções de Processamento Específicas para Cada Estrutura
-
-// Processa arquivo usando DicionarioAvl
-void processar_com_avl(const std::string& caminho_arquivo) {
-    DicionarioAvl<std::string, int> dicionario;
-
-    // Resetar contadores (assumindo que DicionarioAvl tem resetComparacoes e resetRotacoes)
-    dicionario.resetComparacoes();
-    dicionario.resetRotacoes();
-
-    auto start = std::chrono::high_resolution_clock::now();
-    std::ifstream arquivo(caminho_arquivo);
-    if (!arquivo.is_open()) {
+// Lê do arquivo as linhas que começam na faixa de bytes [inicio, fim), separa as palavras por
+// espaço, normaliza cada uma com limpar_e_minusculo e chama 'processar' para as não vazias.
+// Uma linha que cruza 'inicio' pertence à faixa anterior, então faixas contíguas cobrem o
+// arquivo sem repetir nem perder linhas (usado para dividir a leitura entre threads).
+// Com 'metricas' não nulo, o tempo de cada fase (leitura, tokenização, normalização, contagem)
+// e os totais de bytes/tokens são acumulados nele.
+// Arquivos gzip (reconhecidos pelos bytes mágicos) são descompactados em memória por BufferGzip,
+// numa thread paralela à tokenização; as faixas de bytes se referem ao texto descompactado.
+// Retorna false (e avisa em std::cerr) se o arquivo não puder ser aberto ou descompactado.
+template <typename Funcao>
+bool percorrer_palavras_intervalo(const std::string& caminho_arquivo, std::streamoff inicio, std::streamoff fim,
+                                  Funcao&& processar, MetricasFases* metricas = nullptr) {
+    std::ifstream arquivo_texto;
+    std::unique_ptr<BufferGzip> gzip;
+    std::istream arquivo(nullptr);
+    std::error_code erro_status;
+    if (std::filesystem::is_directory(caminho_arquivo, erro_status)) {
+        // Um diretório abre como ifstream no Linux, mas a leitura falha logo na primeira linha.
+        std::cerr << "Erro ao abrir arquivo: " << caminho_arquivo << " (é um diretório)" << std::endl;
+        return false;
+    }
+    if (eh_gzip(caminho_arquivo)) {
+        gzip = std::make_unique<BufferGzip>(caminho_arquivo);
+        if (gzip->aberto()) arquivo.rdbuf(gzip.get());
+    } else {
+        arquivo_texto.open(caminho_arquivo);
+        if (arquivo_texto.is_open()) arquivo.rdbuf(arquivo_texto.rdbuf());
+    }
+    if (!arquivo.rdbuf()) {
         std::cerr << "Erro ao abrir arquivo: " << caminho_arquivo << std::endl;
-        return;
+        return false;
     }
+    // Erro de descompactação: as palavras lidas até ali já foram processadas.
+    auto concluir = [&]() {
+        std::string erro = gzip ? gzip->erro() : std::string();
+        if (erro.empty()) return true;
+        std::cerr << "Erro ao descompactar arquivo: " << caminho_arquivo << " (" << erro << ")" << std::endl;
+        return false;
+    };
 
     std::string linha;
-    while (std::getline(arquivo, linha)) {
+    std::streamoff posicao = 0; // Offset do início da próxima linha
+    if (inicio > 0) {
+        // Posiciona no byte anterior e descarta o resto daquela linha.
+        // O fluxo descompactado não tem acesso aleatório: os bytes anteriores são lidos e descartados.
+        if (gzip) arquivo.ignore(inicio - 1);
+        else arquivo.seekg(inicio - 1);
+        std::getline(arquivo, linha);
+        posicao = inicio + static_cast<std::streamoff>(linha.size());
+    }
+
+    if (!metricas) {
+        while (posicao < fim && std::getline(arquivo, linha)) {
+            posicao += static_cast<std::streamoff>(linha.size()) + 1;
+            std::istringstream iss(linha);
+            std::string palavra;
+            while (iss >> palavra) {
+                std::string limpa = limpar_e_minusculo(palavra);
+                if (!limpa.empty()) {
+                    processar(limpa);
+                }
+            }
+        }
+        return concluir();
+    }
+
+    // Mesmo laço, cronometrando cada etapa.
+    using Relogio = MetricasFases::Relogio;
+    Relogio::time_point t0 = Relogio::now();
+    while (posicao < fim) {
+        bool leu = static_cast<bool>(std::getline(arquivo, linha));
+        Relogio::time_point t1 = Relogio::now();
+        metricas->adicionar(MetricasFases::LEITURA, t1 - t0);
+        if (!leu) break;
+        posicao += static_cast<std::streamoff>(linha.size()) + 1;
+        metricas->bytes += linha.size() + 1;
+
         std::istringstream iss(linha);
         std::string palavra;
-        while (iss >> palavra) {
+        while (true) {
+            Relogio::time_point antes = Relogio::now();
+            bool tem_palavra = static_cast<bool>(iss >> palavra);
+            Relogio::time_point tokenizado = Relogio::now();
+            metricas->adicionar(MetricasFases::TOKENIZACAO, tokenizado - antes);
+            if (!tem_palavra) break;
+            metricas->tokens++;
+
             std::string limpa = limpar_e_minusculo(palavra);
+            Relogio::time_point normalizado = Relogio::now();
+            metricas->adicionar(MetricasFases::NORMALIZACAO, normalizado - tokenizado);
             if (!limpa.empty()) {
-                if (dicionario.contains(limpa)) {
-                    int atual = dicionario.count(limpa);
-                    dicionario.add(limpa, atual + 1);
-                } else {
-                    dicionario.add(limpa, 1);
-                }
+                metricas->palavras++;
+                processar(limpa);
+                metricas->adicionar(MetricasFases::CONTAGEM, Relogio::now() - normalizado);
             }
         }
+        t0 = Relogio::now();
+    }
+    return concluir();
+}
+
+// Percorre todas as palavras normalizadas do arquivo (ver percorrer_palavras_intervalo).
+template <typename Funcao>
+bool percorrer_palavras(const std::string& caminho_arquivo, Funcao&& processar, MetricasFases* metricas = nullptr) {
+    return percorrer_palavras_intervalo(caminho_arquivo, 0, std::numeric_limits<std::streamoff>::max(),
+                                        std::forward<Funcao>(processar), metricas);
+}
+
+// Percorre as palavras da entrada de uma execução, vindas de uma destas fontes:
+// - 'opcoes.tokens': tokens já normalizados em memória (modo 'all');
+// - com --tokens, o arquivo é um arquivo de tokens (--dump-tokens), mapeado na memória;
+// - nos demais casos, as palavras do arquivo de texto (percorrer_palavras).
+// Nas duas primeiras não há leitura de texto nem normalização: as métricas só têm a contagem.
+template <typename Funcao>
+bool percorrer_entrada(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes, Funcao&& processar,
+                       MetricasFases* metricas = nullptr) {
+    if (!opcoes.tokens && !opcoes.entrada_tokens)
+        return percorrer_palavras(caminho_arquivo, std::forward<Funcao>(processar), metricas);
+
+    auto contar = [&](const std::string& limpa) {
+        if (!metricas) {
+            processar(limpa);
+            return;
+        }
+        MetricasFases::Relogio::time_point antes = MetricasFases::Relogio::now();
+        metricas->tokens++;
+        metricas->palavras++;
+        processar(limpa);
+        metricas->adicionar(MetricasFases::CONTAGEM, MetricasFases::Relogio::now() - antes);
+    };
+    if (opcoes.tokens) {
+        opcoes.tokens->percorrer(contar);
+        return true;
     }
+
+    ArquivoTokens arquivo(caminho_arquivo);
+    if (arquivo.aberto()) {
+        if (metricas) metricas->bytes += arquivo.bytes();
+        arquivo.percorrer(contar);
+    }
+    if (!arquivo.aberto()) {
+        std::cerr << "Erro ao ler arquivo de tokens: " << caminho_arquivo << " (" << arquivo.erro() << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Estima o número de palavras distintas do arquivo com HyperLogLog. O arquivo é dividido em
+// 'num_threads' faixas de bytes; cada thread alimenta seu próprio sketch e no fim eles são mesclados.
+// Um .gz é lido por uma só thread (cada faixa teria de descompactar tudo o que vem antes dela).
+bool estimar_distintas(const std::string& caminho_arquivo, size_t num_threads, HyperLogLog<std::string>& resultado) {
+    std::ifstream arquivo(caminho_arquivo, std::ios::ate);
+    if (!arquivo.is_open()) {
+        std::cerr << "Erro ao abrir arquivo: " << caminho_arquivo << std::endl;
+        return false;
+    }
+    std::streamoff tamanho = arquivo.tellg();
     arquivo.close();
+
+    num_threads = eh_gzip(caminho_arquivo) ? 1 : std::max<size_t>(num_threads, 1);
+    std::vector<HyperLogLog<std::string>> sketches(num_threads, HyperLogLog<std::string>(resultado.precisao()));
+    std::vector<char> sucesso(num_threads, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+        std::streamoff inicio = tamanho * static_cast<std::streamoff>(t) / static_cast<std::streamoff>(num_threads);
+        std::streamoff fim = (t + 1 == num_threads) ? std::numeric_limits<std::streamoff>::max()
+                           : tamanho * static_cast<std::streamoff>(t + 1) / static_cast<std::streamoff>(num_threads);
+        threads.emplace_back([&, t, inicio, fim]() {
+            sucesso[t] = percorrer_palavras_intervalo(caminho_arquivo, inicio, fim,
+                [&](const std::string& limpa) { sketches[t].add(limpa); });
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    for (size_t t = 0; t < num_threads; ++t) {
+        if (!sucesso[t]) return false;
+        resultado.merge(sketches[t]);
+    }
+    return true;
+}
+
+// Estima as palavras distintas do arquivo lendo só os primeiros 'bytes_amostra' bytes.
+// A amostra dá o número de tokens por byte e a curva de vocabulário V(n) = K * n^beta (lei de
+// Heaps); beta é ajustado entre o último ponto de controle (potência de dois de tokens) e o fim
+// da amostra e a curva é extrapolada até o total de tokens previsto pelo tamanho do arquivo.
+// Como beta diminui ao longo do texto, o valor local tende a superestimar (erra para o lado seguro).
+// Arquivos menores que a amostra são lidos inteiros e o resultado é exato.
+// Num .gz o tamanho é o descompactado registrado no próprio arquivo (ver tamanho_descompactado).
+size_t estimar_distintas_por_amostra(const std::string& caminho_arquivo, std::streamoff bytes_amostra = 1 << 20) {
+    std::ifstream arquivo(caminho_arquivo, std::ios::ate);
+    if (!arquivo.is_open()) {
+        std::cerr << "Erro ao abrir arquivo: " << caminho_arquivo << std::endl;
+        return 0;
+    }
+    std::streamoff tamanho = arquivo.tellg();
+    arquivo.close();
+    if (eh_gzip(caminho_arquivo)) tamanho = std::max(tamanho, tamanho_descompactado(caminho_arquivo));
+
+    std::unordered_set<std::string> vistas;
+    size_t tokens = 0;
+    size_t proximo_controle = 1024;
+    size_t tokens_controle = 0, distintas_controle = 0;
+    percorrer_palavras_intervalo(caminho_arquivo, 0, bytes_amostra, [&](const std::string& limpa) {
+        vistas.insert(limpa);
+        if (++tokens == proximo_controle) {
+            tokens_controle = tokens;
+            distintas_controle = vistas.size();
+            proximo_controle *= 2;
+        }
+    });
+    if (tamanho <= bytes_amostra || tokens == 0) return vistas.size();
+
+    double beta = 1.0;
+    if (tokens_controle && tokens > tokens_controle && vistas.size() > distintas_controle) {
+        beta = std::log(static_cast<double>(vistas.size()) / distintas_controle) /
+               std::log(static_cast<double>(tokens) / tokens_controle);
+    }
+    beta = std::min(1.0, std::max(0.3, beta));
+    double tokens_total = static_cast<double>(tokens) * tamanho / bytes_amostra;
+    double distintas = vistas.size() * std::pow(tokens_total / tokens, beta);
+    return static_cast<size_t>(std::min(distintas, tokens_total));
+}
+
+// Palavras distintas para reservar nas tabelas hash antes da contagem (0 = não reservar).
+// --presize usa o HyperLogLog do arquivo inteiro, com margem de 3 erros padrão;
+// --presize-sample usa a extrapolação de uma amostra do início do arquivo.
+// Com os tokens já prontos (modo 'all' ou --tokens), as duas usam o HyperLogLog dos tokens.
+size_t distintas_para_reserva(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes) {
+    if ((opcoes.tokens || opcoes.entrada_tokens) && (opcoes.pre_dimensionar || opcoes.pre_dimensionar_amostra)) {
+        HyperLogLog<std::string> sketch;
+        if (!percorrer_entrada(caminho_arquivo, opcoes, [&](const std::string& limpa) { sketch.add(limpa); })) return 0;
+        return static_cast<size_t>(sketch.estimate() * (1.0 + 3.0 * sketch.erroPadrao()));
+    }
+    if (opcoes.pre_dimensionar) {
+        HyperLogLog<std::string> sketch;
+        if (!estimar_distintas(caminho_arquivo, opcoes.num_threads, sketch)) return 0;
+        return static_cast<size_t>(sketch.estimate() * (1.0 + 3.0 * sketch.erroPadrao()));
+    }
+    if (opcoes.pre_dimensionar_amostra) return estimar_distintas_por_amostra(caminho_arquivo);
+    return 0;
+}
+
+// Funções de Processamento Específicas para Cada Estrutura
+
+// Escreve um contador da política de estatísticas (ou avisa que a contagem foi desligada).
+template <typename Stats>
+void escrever_contador(std::ofstream& saida, const char* rotulo, long long valor) {
+    saida << rotulo << ": ";
+    if (Stats::ativo) saida << valor;
+    else saida << "desativado (--no-stats)";
+    saida << "\n";
+}
+
+// Processa arquivo usando DicionarioAvl
+template <typename Stats, typename Chave>
+ResumoExecucao processar_com_avl(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes) {
+    DicionarioAvl<Chave, int, Stats> dicionario;
+
+    // Resetar contadores (assumindo que DicionarioAvl tem resetComparacoes e resetRotacoes)
+    dicionario.resetComparacoes();
+    dicionario.resetRotacoes();
+
+    ContadoresHardware contadores_hw(opcoes.contadores_hw);
+    MetricasFases metricas;
+    MetricasFases* metricas_ativas = opcoes.formato_stats.empty() ? nullptr : &metricas;
+    auto start = std::chrono::high_resolution_clock::now();
+    contadores_hw.iniciar();
+    CacheRecente<DicionarioAvl<Chave, int, Stats>, Chave> cache(dicionario, opcoes.entradas_cache);
+    bool lido = percorrer_entrada(caminho_arquivo, opcoes, [&](const std::string& palavra) {
+        const Chave& limpa = palavra; // Converte uma vez (com std::string é só uma referência)
+        if (opcoes.entradas_cache) {
+            cache.incrementar(limpa); // Acerto no cache: incrementa sem descer na árvore
+        } else if (dicionario.contains(limpa)) {
+            int atual = dicionario.count(limpa);
+            dicionario.add(limpa, atual + 1);
+        } else {
+            dicionario.add(limpa, 1);
+        }
+    }, metricas_ativas);
+    contadores_hw.parar();
     auto end = std::chrono::high_resolution_clock::now();
+    if (!lido) return {};
 
     long long duracao_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
     double duracao_s = static_cast<double>(duracao_ns) / 1e9;
 
+    std::vector<std::pair<Chave, int>> vetor_palavras_frequencias;
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::COLETA);
+        vetor_palavras_frequencias = dicionario.getAllOrdered(); // AVL já retorna ordenado
+    }
+
+    MetricasFases::Cronometro cronometro_escrita(metricas_ativas, MetricasFases::ESCRITA);
     std::ofstream saida("saida_avl.txt");
     if (!saida.is_open()) {
         std::cerr << "Erro ao criar arquivo de saída: saida_avl.txt" << std::endl;
-        return;
+        return {};
     }
 
     saida << "A ESTRUTURA AVL TEM AS SEGUINTES INFORMAÇÕES: \n";
     saida << "tempo de montagem: " << duracao_ns << " nanosegundos (" << std::fixed << std::setprecision(9) << duracao_s << " segundos)\n";
-    saida << "número de comparações de chaves: " << dicionario.getComparacoesPrincipais() << "\n";
-    saida << "número de rotações: " << dicionario.getRotacoes() << "\n\n";
+    escrever_contador<Stats>(saida, "número de comparações de chaves (desempates além do prefixo de 8 bytes)", dicionario.getComparacoesPrincipais());
+    escrever_contador<Stats>(saida, "número de rotações", dicionario.getRotacoes());
+    if (opcoes.entradas_cache) cache.escrever(saida);
+    if (opcoes.estatisticas_arvore) dicionario.estatisticasForma().escrever(saida);
+    contadores_hw.escrever(saida);
+    saida << "\n";
 
     saida << std::left << std::setw(25) << "Palavra" << "Frequencia\n";
     saida << "--------------------------------------\n";
 
-    auto vetor_palavras_frequencias = dicionario.getAllOrdered(); // AVL já retorna ordenado
     for (const auto& p : vetor_palavras_frequencias) {
         saida << std::left << std::setw(25) << p.first << p.second << "\n";
     }
 
     saida.close();
+    cronometro_escrita.parar();
+    if (metricas_ativas) {
+        metricas.salvar("saida_avl", opcoes.formato_stats, "avl", caminho_arquivo, duracao_ns, vetor_palavras_frequencias.size());
+    }
     std::cout << "Arquivo 'saida_avl.txt' gerado com sucesso!\n";
+    return {true, duracao_ns, dicionario.getComparacoesPrincipais(), dicionario.getRotacoes(), vetor_palavras_frequencias.size(), Stats::ativo, true};
 }
 
 // Processa arquivo usando DicionarioChained (Hash Encadeada)
-void processar_com_chained(const std::string& caminho_arquivo) {
-    DicionarioChained<std::string, int> dicionario;
+// Com --presize/--presize-sample, a tabela reserva as palavras distintas estimadas em vez de começar com 19 buckets.
+// 'Reordenacao' é a política das cadeias escolhida com --chain-order.
+template <typename Stats, typename Chave, typename Reordenacao>
+ResumoExecucao processar_com_chained(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes) {
+    DicionarioChained<Chave, int, Reordenacao, Stats> dicionario;
+    dicionario.reserve(distintas_para_reserva(caminho_arquivo, opcoes));
+    size_t capacidade_inicial = dicionario.bucket_count();
 
     // Resetar contadores (assumindo que DicionarioChained tem resetComparacoes e resetRehash)
     dicionario.resetComparacoes();
     dicionario.resetRehash();
 
+    ContadoresHardware contadores_hw(opcoes.contadores_hw);
+    MetricasFases metricas;
+    MetricasFases* metricas_ativas = opcoes.formato_stats.empty() ? nullptr : &metricas;
     auto start = std::chrono::high_resolution_clock::now();
-    std::ifstream arquivo(caminho_arquivo);
-    if (!arquivo.is_open()) {
-        std::cerr << "Erro ao abrir arquivo: " << caminho_arquivo << std::endl;
-        return;
-    }
-
-    std::string linha;
-    while (std::getline(arquivo, linha)) {
-        std::istringstream iss(linha);
-        std::string palavra;
-        while (iss >> palavra) {
-            std::string limpa = limpar_e_minusculo(palavra);
-            if (!limpa.empty()) {
-                // Para DicionarioChained, 'add' já atualiza o valor se a chave existe
-                int atual = dicionario.count(limpa); // Se não existe, retorna 0 (ValueType default)
-                dicionario.add(limpa, atual + 1);    // Adiciona ou atualiza
-            }
+    contadores_hw.iniciar();
+    CacheRecente<DicionarioChained<Chave, int, Reordenacao, Stats>, Chave> cache(dicionario, opcoes.entradas_cache);
+    bool lido = percorrer_entrada(caminho_arquivo, opcoes, [&](const std::string& palavra) {
+        const Chave& limpa = palavra; // Converte uma vez (com std::string é só uma referência)
+        if (opcoes.entradas_cache) {
+            cache.incrementar(limpa); // Acerto no cache: incrementa sem percorrer a cadeia
+            return;
         }
-    }
-    arquivo.close();
+        // Para DicionarioChained, 'add' já atualiza o valor se a chave existe
+        int atual = dicionario.count(limpa); // Se não existe, retorna 0 (ValueType default)
+        dicionario.add(limpa, atual + 1);    // Adiciona ou atualiza
+    }, metricas_ativas);
+    contadores_hw.parar();
     auto end = std::chrono::high_resolution_clock::now();
+    if (!lido) return {};
 
     long long duracao_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
     double duracao_s = static_cast<double>(duracao_ns) / 1e9;
 
+    std::vector<std::pair<Chave, int>> vetor_palavras_frequencias;
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::COLETA);
+        dicionario.getAllPairs(vetor_palavras_frequencias); // Coleta todos os pares
+    }
+
+    // Opcional: Ordenar o vetor para ter a saída em ordem alfabética (Hash Tables não garantem ordem)
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::ORDENACAO);
+        std::sort(vetor_palavras_frequencias.begin(), vetor_palavras_frequencias.end(),
+                  [](const std::pair<Chave, int>& a, const std::pair<Chave, int>& b) {
+                      return a.first < b.first;
+                  });
+    }
+
+    MetricasFases::Cronometro cronometro_escrita(metricas_ativas, MetricasFases::ESCRITA);
     std::ofstream saida("saida_chained.txt");
     if (!saida.is_open()) {
         std::cerr << "Erro ao criar arquivo de saída: saida_chained.txt" << std::endl;
-        return;
+        return {};
     }
 
     saida << "A ESTRUTURA HASH ENCADEADA TEM AS SEGUINTES INFORMAÇÕES: \n";
     saida << "tempo de montagem: " << duracao_ns << " nanosegundos (" << std::fixed << std::setprecision(9) << duracao_s << " segundos)\n";
     // Corrigido para getComparacoesPrincipal() conforme seu código
-    saida << "número de comparações de chaves: " << dicionario.getComparacoesPrincipal() << "\n";
+    escrever_contador<Stats>(saida, "número de comparações de chaves", dicionario.getComparacoesPrincipal());
     // Corrigido para getContadorRehash() conforme seu código
-    saida << "número de rehashes: " << dicionario.getContadorRehash() << "\n\n";
+    escrever_contador<Stats>(saida, "número de rehashes", dicionario.getContadorRehash());
+    saida << "capacidade inicial: " << capacidade_inicial << " buckets\n";
+    saida << "reordenação das cadeias: " << Reordenacao::nome << "\n";
+    if (opcoes.entradas_cache) cache.escrever(saida);
+    if (opcoes.estatisticas_hash) dicionario.estatisticas().escrever(saida);
+    contadores_hw.escrever(saida);
+    saida << "\n";
 
     saida << std::left << std::setw(25) << "Palavra" << "Frequencia\n";
     saida << "--------------------------------------\n";
 
-    std::vector<std::pair<std::string, int>> vetor_palavras_frequencias;
-    dicionario.getAllPairs(vetor_palavras_frequencias); // Coleta todos os pares
-
-    // Opcional: Ordenar o vetor para ter a saída em ordem alfabética (Hash Tables não garantem ordem)
-    std::sort(vetor_palavras_frequencias.begin(), vetor_palavras_frequencias.end(),
-              [](const std::pair<std::string, int>& a, const std::pair<std::string, int>& b) {
-                  return a.first < b.first;
-              });
-
     for (const auto& p : vetor_palavras_frequencias) {
         saida << std::left << std::setw(25) << p.first << p.second << "\n";
     }
 
     saida.close();
+    cronometro_escrita.parar();
+    if (metricas_ativas) {
+        metricas.salvar("saida_chained", opcoes.formato_stats, "chained", caminho_arquivo, duracao_ns, vetor_palavras_frequencias.size());
+    }
     std::cout << "Arquivo 'saida_chained.txt' gerado com sucesso!\n";
+    return {true, duracao_ns, dicionario.getComparacoesPrincipal(), dicionario.getContadorRehash(), vetor_palavras_frequencias.size(), Stats::ativo};
 }
 
 // Processa arquivo usando HashAberto (Endereçamento Aberto)
-void processar_com_open(const std::string& caminho_arquivo) {
-    HashAberto<std::string, int> dicionario;
+// Com --presize/--presize-sample, a tabela reserva as palavras distintas estimadas em vez de começar com 19 slots.
+template <typename Stats, typename Chave>
+ResumoExecucao processar_com_open(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes) {
+    DicionarioOpen<Chave, int, Stats> dicionario;
+    dicionario.reserve(distintas_para_reserva(caminho_arquivo, opcoes));
+    size_t capacidade_inicial = dicionario.bucket_count();
+
+    ContadoresHardware contadores_hw(opcoes.contadores_hw);
+    MetricasFases metricas;
+    MetricasFases* metricas_ativas = opcoes.formato_stats.empty() ? nullptr : &metricas;
+    auto start = std::chrono::high_resolution_clock::now();
+    contadores_hw.iniciar();
+    CacheRecente<DicionarioOpen<Chave, int, Stats>, Chave> cache(dicionario, opcoes.entradas_cache);
+    bool lido = percorrer_entrada(caminho_arquivo, opcoes, [&](const std::string& palavra) {
+        const Chave& limpa = palavra; // Converte uma vez (com std::string é só uma referência)
+        if (opcoes.entradas_cache) {
+            cache.incrementar(limpa); // Acerto no cache: incrementa sem sondar a tabela
+            return;
+        }
+        try {
+            int atual = dicionario.at(limpa); 
+            dicionario.inserir(limpa, atual + 1); // Atualiza com novo valor
+        } catch (const std::out_of_range& e) {
+            dicionario.inserir(limpa, 1); // Insere pela primeira vez
+        }
+    }, metricas_ativas);
+    contadores_hw.parar();
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!lido) return {};
+
+    long long duracao_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double duracao_s = static_cast<double>(duracao_ns) / 1e9;
+
+    std::vector<std::pair<Chave, int>> vetor_palavras_frequencias;
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::COLETA);
+        dicionario.getAllPairs(vetor_palavras_frequencias); // Ignora slots vazios e removidos
+    }
+
+    // ordenar o vetor para ter a saída em ordem alfabética
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::ORDENACAO);
+        std::sort(vetor_palavras_frequencias.begin(), vetor_palavras_frequencias.end(),
+                  [](const std::pair<Chave, int>& a, const std::pair<Chave, int>& b) {
+                      return a.first < b.first;
+                  });
+    }
+
+    MetricasFases::Cronometro cronometro_escrita(metricas_ativas, MetricasFases::ESCRITA);
+    std::ofstream saida("saida_open.txt");
+    if (!saida.is_open()) {
+        std::cerr << "Erro ao criar arquivo de saída: saida_open.txt" << std::endl;
+        return {};
+    }
 
-    // Resetar contadores (assumindo que HashAberto tem resetComparacoes e resetRehash)
-    //dicionario.resetComparacoes();
-    //dicionario.resetRehash(); // No seu HashAberto, isso é m_rehashes
+    saida << "A ESTRUTURA HASH ABERTO TEM AS SEGUINTES INFORMAÇÕES: \n";
+    saida << "tempo de montagem: " << duracao_ns << " nanosegundos (" << std::fixed << std::setprecision(9) << duracao_s << " segundos)\n";
+    escrever_contador<Stats>(saida, "número de comparações de chaves", dicionario.getComparacoesPrincipais());
+    escrever_contador<Stats>(saida, "número de rehashes", dicionario.getContadorRehash());
+    saida << "capacidade inicial: " << capacidade_inicial << " slots\n";
+    if (opcoes.entradas_cache) cache.escrever(saida);
+    if (opcoes.estatisticas_hash) dicionario.estatisticas().escrever(saida);
+    contadores_hw.escrever(saida);
+    saida << "\n";
+
+    saida << std::left << std::setw(25) << "Palavra" << "Frequencia\n";
+    saida << "--------------------------------------\n";
+
+    for (const auto& p : vetor_palavras_frequencias) {
+        saida << std::left << std::setw(25) << p.first << p.second << "\n";
+    }
 
+    saida.close();
+    cronometro_escrita.parar();
+    if (metricas_ativas) {
+        metricas.salvar("saida_open", opcoes.formato_stats, "open", caminho_arquivo, duracao_ns, vetor_palavras_frequencias.size());
+    }
+    std::cout << "Arquivo 'saida_open.txt' gerado com sucesso!\n";
+    return {true, duracao_ns, static_cast<long long>(dicionario.getComparacoesPrincipais()), static_cast<long long>(dicionario.getContadorRehash()), vetor_palavras_frequencias.size(), Stats::ativo};
+}
+
+// Processa arquivo usando DicionarioRobin (Endereçamento Aberto com Robin Hood)
+// Com --presize/--presize-sample, a tabela reserva as palavras distintas estimadas (fator de carga 0.9).
+template <typename Stats, typename Chave>
+void processar_com_robin(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes) {
+    DicionarioRobin<Chave, int, Stats> dicionario;
+    dicionario.reserve(distintas_para_reserva(caminho_arquivo, opcoes));
+    size_t capacidade_inicial = dicionario.bucket_count(); // Potência de dois
+
+    // Resetar contadores
+    dicionario.resetComparacoes();
+    dicionario.resetRehash();
+
+    ContadoresHardware contadores_hw(opcoes.contadores_hw);
+    MetricasFases metricas;
+    MetricasFases* metricas_ativas = opcoes.formato_stats.empty() ? nullptr : &metricas;
     auto start = std::chrono::high_resolution_clock::now();
-    std::ifstream arquivo(caminho_arquivo);
-    if (!arquivo.is_open()) {
-        std::cerr << "Erro ao abrir arquivo: " << caminho_arquivo << std::endl;
+    contadores_hw.iniciar();
+    bool lido = percorrer_entrada(caminho_arquivo, opcoes, [&](const std::string& palavra) {
+        const Chave& limpa = palavra; // Converte uma vez (com std::string é só uma referência)
+        int atual = dicionario.count(limpa); // Se não existe, retorna 0 (ValueType default)
+        dicionario.add(limpa, atual + 1);    // Adiciona ou atualiza
+    }, metricas_ativas);
+    contadores_hw.parar();
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!lido) return;
+
+    long long duracao_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double duracao_s = static_cast<double>(duracao_ns) / 1e9;
+
+    std::vector<std::pair<Chave, int>> vetor_palavras_frequencias;
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::COLETA);
+        dicionario.getAllPairs(vetor_palavras_frequencias); // Coleta todos os pares
+    }
+
+    // Ordena o vetor para ter a saída em ordem alfabética
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::ORDENACAO);
+        std::sort(vetor_palavras_frequencias.begin(), vetor_palavras_frequencias.end(),
+                  [](const std::pair<Chave, int>& a, const std::pair<Chave, int>& b) {
+                      return a.first < b.first;
+                  });
+    }
+
+    MetricasFases::Cronometro cronometro_escrita(metricas_ativas, MetricasFases::ESCRITA);
+    std::ofstream saida("saida_robin.txt");
+    if (!saida.is_open()) {
+        std::cerr << "Erro ao criar arquivo de saída: saida_robin.txt" << std::endl;
         return;
     }
 
-    std::string linha;
-    while (std::getline(arquivo, linha)) {
-        std::istringstream iss(linha);
-        std::string palavra;
-        while (iss >> palavra) {
-            std::string limpa = limpar_e_minusculo(palavra);
-            if (!limpa.empty()) {
-                
-                try {
-                    int atual = dicionario.at(limpa); 
-                    dicionario.insert(limpa, atual + 1); // Atualiza com novo valor
-                } catch (const std::out_of_range& e) {
-                    dicionario.insert(limpa, 1); // Insere pela primeira vez
-                }
-            }
-        }
+    saida << "A ESTRUTURA HASH ROBIN HOOD TEM AS SEGUINTES INFORMAÇÕES: \n";
+    saida << "tempo de montagem: " << duracao_ns << " nanosegundos (" << std::fixed << std::setprecision(9) << duracao_s << " segundos)\n";
+    escrever_contador<Stats>(saida, "número de comparações de chaves", dicionario.getComparacoesPrincipais());
+    escrever_contador<Stats>(saida, "número de rehashes", dicionario.getContadorRehash());
+    saida << "capacidade inicial: " << capacidade_inicial << " slots\n";
+    if (opcoes.estatisticas_hash) dicionario.estatisticas().escrever(saida);
+    contadores_hw.escrever(saida);
+    saida << "\n";
+
+    saida << std::left << std::setw(25) << "Palavra" << "Frequencia\n";
+    saida << "--------------------------------------\n";
+
+    for (const auto& p : vetor_palavras_frequencias) {
+        saida << std::left << std::setw(25) << p.first << p.second << "\n";
     }
-    arquivo.close();
+
+    saida.close();
+    cronometro_escrita.parar();
+    if (metricas_ativas) {
+        metricas.salvar("saida_robin", opcoes.formato_stats, "robin", caminho_arquivo, duracao_ns, vetor_palavras_frequencias.size());
+    }
+    std::cout << "Arquivo 'saida_robin.txt' gerado com sucesso!\n";
+}
+
+// Processa arquivo usando DicionarioCuckoo (Cuckoo com baldes de 4 posições)
+// Com --presize/--presize-sample, a tabela reserva as palavras distintas estimadas (fator de carga 0.95).
+template <typename Stats, typename Chave>
+void processar_com_cuckoo(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes) {
+    DicionarioCuckoo<Chave, int, Stats> dicionario;
+    dicionario.reserve(distintas_para_reserva(caminho_arquivo, opcoes));
+    size_t capacidade_inicial = dicionario.bucket_count(); // Baldes em potência de dois
+
+    // Resetar contadores
+    dicionario.resetComparacoes();
+    dicionario.resetRehash();
+    dicionario.resetDeslocamentos();
+
+    ContadoresHardware contadores_hw(opcoes.contadores_hw);
+    MetricasFases metricas;
+    MetricasFases* metricas_ativas = opcoes.formato_stats.empty() ? nullptr : &metricas;
+    auto start = std::chrono::high_resolution_clock::now();
+    contadores_hw.iniciar();
+    bool lido = percorrer_entrada(caminho_arquivo, opcoes, [&](const std::string& palavra) {
+        const Chave& limpa = palavra; // Converte uma vez (com std::string é só uma referência)
+        int atual = dicionario.count(limpa); // Se não existe, retorna 0 (ValueType default)
+        dicionario.add(limpa, atual + 1);    // Adiciona ou atualiza
+    }, metricas_ativas);
+    contadores_hw.parar();
     auto end = std::chrono::high_resolution_clock::now();
+    if (!lido) return;
 
     long long duracao_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
     double duracao_s = static_cast<double>(duracao_ns) / 1e9;
 
-    std::ofstream saida("saida_open.txt");
+    std::vector<std::pair<Chave, int>> vetor_palavras_frequencias;
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::COLETA);
+        dicionario.getAllPairs(vetor_palavras_frequencias); // Coleta todos os pares
+    }
+
+    // Ordena o vetor para ter a saída em ordem alfabética
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::ORDENACAO);
+        std::sort(vetor_palavras_frequencias.begin(), vetor_palavras_frequencias.end(),
+                  [](const std::pair<Chave, int>& a, const std::pair<Chave, int>& b) {
+                      return a.first < b.first;
+                  });
+    }
+
+    MetricasFases::Cronometro cronometro_escrita(metricas_ativas, MetricasFases::ESCRITA);
+    std::ofstream saida("saida_cuckoo.txt");
     if (!saida.is_open()) {
-        std::cerr << "Erro ao criar arquivo de saída: saida_open.txt" << std::endl;
+        std::cerr << "Erro ao criar arquivo de saída: saida_cuckoo.txt" << std::endl;
         return;
     }
 
-    saida << "A ESTRUTURA HASH ABERTO TEM AS SEGUINTES INFORMAÇÕES: \n";
+    saida << "A ESTRUTURA HASH CUCKOO TEM AS SEGUINTES INFORMAÇÕES: \n";
     saida << "tempo de montagem: " << duracao_ns << " nanosegundos (" << std::fixed << std::setprecision(9) << duracao_s << " segundos)\n";
-    saida << "número de comparações de chaves: " << dicionario.getComparacoesPrincipais() << "\n";
-    saida << "número de rehashes: " << dicionario.getRehashes() << "\n\n";
+    escrever_contador<Stats>(saida, "número de comparações de chaves", dicionario.getComparacoesPrincipais());
+    escrever_contador<Stats>(saida, "número de deslocamentos", dicionario.getDeslocamentos());
+    escrever_contador<Stats>(saida, "número de rehashes", dicionario.getContadorRehash());
+    saida << "chaves no estoque: " << dicionario.tamanhoEstoque() << "\n";
+    saida << "capacidade inicial: " << capacidade_inicial << " slots\n";
+    if (opcoes.estatisticas_hash) dicionario.estatisticas().escrever(saida);
+    contadores_hw.escrever(saida);
+    saida << "\n";
 
     saida << std::left << std::setw(25) << "Palavra" << "Frequencia\n";
     saida << "--------------------------------------\n";
 
-    std::vector<std::pair<std::string, int>> vetor_palavras_frequencias;
-    // Iterar sobre a HashAberto para coletar os pares.
-    for (size_t i = 0; i < dicionario.bucket_count(); ++i) {
-        try {
-            vetor_palavras_frequencias.push_back(dicionario.getPairAt(i));
-        } catch (const std::out_of_range& e) {
-            // Slot VAZIO ou REMOVIDO, ignora.
+    for (const auto& p : vetor_palavras_frequencias) {
+        saida << std::left << std::setw(25) << p.first << p.second << "\n";
+    }
+
+    saida.close();
+    cronometro_escrita.parar();
+    if (metricas_ativas) {
+        metricas.salvar("saida_cuckoo", opcoes.formato_stats, "cuckoo", caminho_arquivo, duracao_ns, vetor_palavras_frequencias.size());
+    }
+    std::cout << "Arquivo 'saida_cuckoo.txt' gerado com sucesso!\n";
+}
+
+// Processa arquivo usando DicionarioRb (Árvore Rubro-Negra)
+template <typename Stats, typename Chave>
+ResumoExecucao processar_com_rb(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes) {
+    DicionarioRb<Chave, int, Stats> dicionario;
+
+    // Resetar contadores (assumindo que DicionarioRb tem resetComparacoes e resetRotacoes)
+    dicionario.resetComparacoes();
+    dicionario.resetRotacoes();
+
+    ContadoresHardware contadores_hw(opcoes.contadores_hw);
+    MetricasFases metricas;
+    MetricasFases* metricas_ativas = opcoes.formato_stats.empty() ? nullptr : &metricas;
+    auto start = std::chrono::high_resolution_clock::now();
+    contadores_hw.iniciar();
+    CacheRecente<DicionarioRb<Chave, int, Stats>, Chave> cache(dicionario, opcoes.entradas_cache);
+    bool lido = percorrer_entrada(caminho_arquivo, opcoes, [&](const std::string& palavra) {
+        const Chave& limpa = palavra; // Converte uma vez (com std::string é só uma referência)
+        if (opcoes.entradas_cache) {
+            cache.incrementar(limpa); // Acerto no cache: incrementa sem descer na árvore
+            return;
         }
+        // Lógica de frequência para DicionarioRb
+        int freq_atual = dicionario.count(limpa); // Obtém a frequência atual (0 se não existe)
+        dicionario.add(limpa, freq_atual + 1);    // Adiciona/atualiza com a nova frequência
+    }, metricas_ativas);
+    contadores_hw.parar();
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!lido) return {};
+
+    long long duracao_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double duracao_s = static_cast<double>(duracao_ns) / 1e9;
+
+    std::vector<std::pair<Chave, int>> vetor_palavras_frequencias;
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::COLETA);
+        dicionario.getAllPairs(vetor_palavras_frequencias); // Coleta todos os pares (já virá ordenada da RB)
     }
 
-    // ordenar o vetor para ter a saída em ordem alfabética
-    std::sort(vetor_palavras_frequencias.begin(), vetor_palavras_frequencias.end(),
-              [](const std::pair<std::string, int>& a, const std::pair<std::string, int>& b) {
-                  return a.first < b.first;
-              });
+    MetricasFases::Cronometro cronometro_escrita(metricas_ativas, MetricasFases::ESCRITA);
+    std::ofstream saida("saida_rb.txt");
+    if (!saida.is_open()) {
+        std::cerr << "Erro ao criar arquivo de saída: saida_rb.txt" << std::endl;
+        return {};
+    }
+
+    saida << "A ESTRUTURA RUBRO-NEGRA TEM AS SEGUINTES INFORMAÇÕES: \n";
+    saida << "tempo de montagem: " << duracao_ns << " nanosegundos (" << std::fixed << std::setprecision(9) << duracao_s << " segundos)\n";
+    escrever_contador<Stats>(saida, "número de comparações de chaves (desempates além do prefixo de 8 bytes)", dicionario.getComparacoesPrincipais());
+    escrever_contador<Stats>(saida, "número de rotações", dicionario.getRotacoes());
+    if (opcoes.entradas_cache) cache.escrever(saida);
+    if (opcoes.estatisticas_arvore) dicionario.estatisticasForma().escrever(saida);
+    contadores_hw.escrever(saida);
+    saida << "\n";
+
+    saida << std::left << std::setw(25) << "Palavra" << "Frequencia\n";
+    saida << "--------------------------------------\n";
 
     for (const auto& p : vetor_palavras_frequencias) {
         saida << std::left << std::setw(25) << p.first << p.second << "\n";
     }
 
     saida.close();
-    std::cout << "Arquivo 'saida_open.txt' gerado com sucesso!\n";
+    cronometro_escrita.parar();
+    if (metricas_ativas) {
+        metricas.salvar("saida_rb", opcoes.formato_stats, "rb", caminho_arquivo, duracao_ns, vetor_palavras_frequencias.size());
+    }
+    std::cout << "Arquivo 'saida_rb.txt' gerado com sucesso!\n";
+    return {true, duracao_ns, dicionario.getComparacoesPrincipais(), dicionario.getRotacoes(), vetor_palavras_frequencias.size(), Stats::ativo, true};
 }
 
-// Processa arquivo usando DicionarioRb (Árvore Rubro-Negra)
-void processar_com_rb(const std::string& caminho_arquivo) {
-    DicionarioRb<std::string, int> dicionario;
+// Processa arquivo usando DicionarioSplay (Árvore Splay)
+// O count traz a palavra para a raiz; o add seguinte a encontra com uma comparação.
+template <typename Stats, typename Chave>
+void processar_com_splay(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes) {
+    DicionarioSplay<Chave, int, Stats> dicionario;
 
-    // Resetar contadores (assumindo que DicionarioRb tem resetComparacoes e resetRotacoes)
+    // Resetar contadores do dicionário
     dicionario.resetComparacoes();
     dicionario.resetRotacoes();
 
+    ContadoresHardware contadores_hw(opcoes.contadores_hw);
+    MetricasFases metricas;
+    MetricasFases* metricas_ativas = opcoes.formato_stats.empty() ? nullptr : &metricas;
     auto start = std::chrono::high_resolution_clock::now();
-    std::ifstream arquivo(caminho_arquivo);
-    if (!arquivo.is_open()) {
-        std::cerr << "Erro ao abrir arquivo: " << caminho_arquivo << std::endl;
+    contadores_hw.iniciar();
+    bool lido = percorrer_entrada(caminho_arquivo, opcoes, [&](const std::string& palavra) {
+        const Chave& limpa = palavra; // Converte uma vez (com std::string é só uma referência)
+        int freq_atual = dicionario.count(limpa); // Obtém a frequência atual (0 se não existe)
+        dicionario.add(limpa, freq_atual + 1);    // Adiciona/atualiza com a nova frequência
+    }, metricas_ativas);
+    contadores_hw.parar();
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!lido) return;
+
+    long long duracao_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double duracao_s = static_cast<double>(duracao_ns) / 1e9;
+
+    std::vector<std::pair<Chave, int>> vetor_palavras_frequencias;
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::COLETA);
+        dicionario.getAllPairs(vetor_palavras_frequencias); // Coleta todos os pares (percurso em ordem da splay)
+    }
+
+    MetricasFases::Cronometro cronometro_escrita(metricas_ativas, MetricasFases::ESCRITA);
+    std::ofstream saida("saida_splay.txt");
+    if (!saida.is_open()) {
+        std::cerr << "Erro ao criar arquivo de saída: saida_splay.txt" << std::endl;
         return;
     }
 
-    std::string linha;
-    while (std::getline(arquivo, linha)) {
-        std::istringstream iss(linha);
-        std::string palavra;
-        while (iss >> palavra) {
-            std::string limpa = limpar_e_minusculo(palavra);
-            if (!limpa.empty()) {
-                // Lógica de frequência para DicionarioRb
-                int freq_atual = dicionario.count(limpa); // Obtém a frequência atual (0 se não existe)
-                dicionario.add(limpa, freq_atual + 1);    // Adiciona/atualiza com a nova frequência
-            }
-        }
+    saida << "A ESTRUTURA SPLAY TEM AS SEGUINTES INFORMAÇÕES: \n";
+    saida << "tempo de montagem: " << duracao_ns << " nanosegundos (" << std::fixed << std::setprecision(9) << duracao_s << " segundos)\n";
+    escrever_contador<Stats>(saida, "número de comparações de chaves (desempates além do prefixo de 8 bytes)", dicionario.getComparacoesPrincipais());
+    escrever_contador<Stats>(saida, "número de rotações", dicionario.getRotacoes());
+    if (opcoes.estatisticas_arvore) dicionario.estatisticasForma().escrever(saida);
+    contadores_hw.escrever(saida);
+    saida << "\n";
+
+    saida << std::left << std::setw(25) << "Palavra" << "Frequencia\n";
+    saida << "--------------------------------------\n";
+
+    for (const auto& p : vetor_palavras_frequencias) {
+        saida << std::left << std::setw(25) << p.first << p.second << "\n";
     }
-    arquivo.close();
+
+    saida.close();
+    cronometro_escrita.parar();
+    if (metricas_ativas) {
+        metricas.salvar("saida_splay", opcoes.formato_stats, "splay", caminho_arquivo, duracao_ns, vetor_palavras_frequencias.size());
+    }
+    std::cout << "Arquivo 'saida_splay.txt' gerado com sucesso!\n";
+}
+
+// Processa arquivo usando DicionarioArt (Árvore Radix Adaptativa)
+template <typename Stats>
+void processar_com_art(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes) {
+    DicionarioArt<std::string, int, Stats> dicionario;
+
+    dicionario.resetComparacoes();
+    dicionario.resetCrescimentos();
+
+    ContadoresHardware contadores_hw(opcoes.contadores_hw);
+    MetricasFases metricas;
+    MetricasFases* metricas_ativas = opcoes.formato_stats.empty() ? nullptr : &metricas;
+    auto start = std::chrono::high_resolution_clock::now();
+    contadores_hw.iniciar();
+    bool lido = percorrer_entrada(caminho_arquivo, opcoes, [&](const std::string& limpa) {
+        int atual = dicionario.count(limpa); // 0 se a palavra ainda não existe
+        dicionario.add(limpa, atual + 1);
+    }, metricas_ativas);
+    contadores_hw.parar();
     auto end = std::chrono::high_resolution_clock::now();
+    if (!lido) return;
 
     long long duracao_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
     double duracao_s = static_cast<double>(duracao_ns) / 1e9;
 
-    std::ofstream saida("saida_rb.txt");
+    std::vector<std::pair<std::string, int>> vetor_palavras_frequencias;
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::COLETA);
+        vetor_palavras_frequencias = dicionario.getAllOrdered(); // ART percorre em ordem lexicográfica
+    }
+
+    MetricasFases::Cronometro cronometro_escrita(metricas_ativas, MetricasFases::ESCRITA);
+    std::ofstream saida("saida_art.txt");
     if (!saida.is_open()) {
-        std::cerr << "Erro ao criar arquivo de saída: saida_rb.txt" << std::endl;
+        std::cerr << "Erro ao criar arquivo de saída: saida_art.txt" << std::endl;
         return;
     }
 
-    saida << "A ESTRUTURA RUBRO-NEGRA TEM AS SEGUINTES INFORMAÇÕES: \n";
+    saida << "A ESTRUTURA ART (ÁRVORE RADIX ADAPTATIVA) TEM AS SEGUINTES INFORMAÇÕES: \n";
     saida << "tempo de montagem: " << duracao_ns << " nanosegundos (" << std::fixed << std::setprecision(9) << duracao_s << " segundos)\n";
-    saida << "número de comparações de chaves: " << dicionario.getComparacoesPrincipais() << "\n";
-    saida << "número de rotações: " << dicionario.getRotacoes() << "\n\n";
+    escrever_contador<Stats>(saida, "número de comparações de chaves", dicionario.getComparacoesPrincipais());
+    escrever_contador<Stats>(saida, "número de crescimentos de nós", dicionario.getCrescimentos());
+    contadores_hw.escrever(saida);
+    saida << "\n";
 
     saida << std::left << std::setw(25) << "Palavra" << "Frequencia\n";
     saida << "--------------------------------------\n";
 
-    std::vector<std::pair<std::string, int>> vetor_palavras_frequencias;
-    dicionario.getAllPairs(vetor_palavras_frequencias); // Coleta todos os pares (já virá ordenada da RB)
+    for (const auto& p : vetor_palavras_frequencias) {
+        saida << std::left << std::setw(25) << p.first << p.second << "\n";
+    }
+
+    saida.close();
+    cronometro_escrita.parar();
+    if (metricas_ativas) {
+        metricas.salvar("saida_art", opcoes.formato_stats, "art", caminho_arquivo, duracao_ns, vetor_palavras_frequencias.size());
+    }
+    std::cout << "Arquivo 'saida_art.txt' gerado com sucesso!\n";
+}
+
+// Processa arquivo em modo aproximado: as frequências vão para um Count-Min Sketch de memória
+// fixa, e um heap de mínimo indexado guarda apenas os 'top_k' candidatos mais frequentes.
+void processar_com_cms(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes) {
+    size_t top_k = opcoes.top_k;
+    CountMinSketch<std::string> sketch(opcoes.largura_cms, opcoes.profundidade_cms);
+    CandidatosTopK<std::string> candidatos(top_k);
+
+    ContadoresHardware contadores_hw(opcoes.contadores_hw);
+    MetricasFases metricas;
+    MetricasFases* metricas_ativas = opcoes.formato_stats.empty() ? nullptr : &metricas;
+    auto start = std::chrono::high_resolution_clock::now();
+    contadores_hw.iniciar();
+    bool lido = percorrer_entrada(caminho_arquivo, opcoes, [&](const std::string& limpa) {
+        // Atualiza o candidato, ocupa uma vaga ou substitui o de menor estimativa (se o superar).
+        candidatos.atualizar(limpa, sketch.add(limpa));
+    }, metricas_ativas);
+    contadores_hw.parar();
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!lido) return;
+
+    long long duracao_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double duracao_s = static_cast<double>(duracao_ns) / 1e9;
+
+    // Reconsulta o sketch (a estimativa de um candidato pode ter subido depois da última atualização)
+    // e ordena por frequência estimada decrescente.
+    std::vector<std::pair<std::string, uint32_t>> vetor_palavras_frequencias;
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::COLETA);
+        candidatos.getAllPairs(vetor_palavras_frequencias);
+        for (auto& p : vetor_palavras_frequencias) {
+            p.second = sketch.estimate(p.first);
+        }
+    }
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::ORDENACAO);
+        std::sort(vetor_palavras_frequencias.begin(), vetor_palavras_frequencias.end(),
+                  [](const std::pair<std::string, uint32_t>& a, const std::pair<std::string, uint32_t>& b) {
+                      if (a.second != b.second) return a.second > b.second;
+                      return a.first < b.first;
+                  });
+    }
+
+    MetricasFases::Cronometro cronometro_escrita(metricas_ativas, MetricasFases::ESCRITA);
+    std::ofstream saida("saida_cms.txt");
+    if (!saida.is_open()) {
+        std::cerr << "Erro ao criar arquivo de saída: saida_cms.txt" << std::endl;
+        return;
+    }
+
+    saida << "A ESTRUTURA COUNT-MIN SKETCH TEM AS SEGUINTES INFORMAÇÕES: \n";
+    saida << "tempo de montagem: " << duracao_ns << " nanosegundos (" << std::fixed << std::setprecision(9) << duracao_s << " segundos)\n";
+    saida << "largura (w): " << sketch.largura() << "\n";
+    saida << "profundidade (d): " << sketch.profundidade() << "\n";
+    saida << "memória fixa do sketch: " << sketch.memoriaBytes() << " bytes\n";
+    saida << "total de palavras (N): " << sketch.total() << "\n";
+    saida << "erro por estimativa: no máximo " << std::setprecision(2) << sketch.erroMaximo()
+          << " ocorrências a mais (εN, ε = e/w = " << std::setprecision(9) << sketch.epsilon() << ")\n";
+    saida << "probabilidade de exceder o erro: " << sketch.delta() << " (δ = e^-d)\n";
+    saida << "candidatos top-K: " << candidatos.size() << " de " << top_k << "\n";
+    contadores_hw.escrever(saida);
+    saida << "\n";
+
+    saida << std::left << std::setw(25) << "Palavra" << "Frequencia\n";
+    saida << "--------------------------------------\n";
 
     for (const auto& p : vetor_palavras_frequencias) {
         saida << std::left << std::setw(25) << p.first << p.second << "\n";
     }
 
     saida.close();
-    std::cout << "Arquivo 'saida_rb.txt' gerado com sucesso!\n";
+    cronometro_escrita.parar();
+    if (metricas_ativas) {
+        metricas.salvar("saida_cms", opcoes.formato_stats, "cms", caminho_arquivo, duracao_ns, vetor_palavras_frequencias.size());
+    }
+    std::cout << "Arquivo 'saida_cms.txt' gerado com sucesso!\n";
+}
+
+// Modo 'heavy': mantém apenas os '--top' elementos mais frequentes com o algoritmo Space-Saving,
+// em memória O(K) e com erro garantido de no máximo N / K por contagem.
+void processar_com_heavy(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes) {
+    SpaceSaving<std::string> resumo(opcoes.top_k);
+
+    ContadoresHardware contadores_hw(opcoes.contadores_hw);
+    MetricasFases metricas;
+    MetricasFases* metricas_ativas = opcoes.formato_stats.empty() ? nullptr : &metricas;
+    auto start = std::chrono::high_resolution_clock::now();
+    contadores_hw.iniciar();
+    bool lido = percorrer_entrada(caminho_arquivo, opcoes, [&](const std::string& limpa) {
+        resumo.add(limpa);
+    }, metricas_ativas);
+    contadores_hw.parar();
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!lido) return;
+
+    long long duracao_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double duracao_s = static_cast<double>(duracao_ns) / 1e9;
+
+    std::vector<std::tuple<std::string, uint64_t, uint64_t>> elementos;
+    std::vector<std::pair<std::string, uint64_t>> vetor_palavras_frequencias;
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::COLETA);
+        elementos = resumo.topK();
+        for (const auto& e : elementos) {
+            vetor_palavras_frequencias.emplace_back(std::get<0>(e), std::get<1>(e));
+        }
+    }
+    // Ordem decrescente de frequência; empates em ordem alfabética.
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::ORDENACAO);
+        std::sort(vetor_palavras_frequencias.begin(), vetor_palavras_frequencias.end(),
+                  [](const std::pair<std::string, uint64_t>& a, const std::pair<std::string, uint64_t>& b) {
+                      if (a.second != b.second) return a.second > b.second;
+                      return a.first < b.first;
+                  });
+    }
+
+    MetricasFases::Cronometro cronometro_escrita(metricas_ativas, MetricasFases::ESCRITA);
+    std::ofstream saida("saida_heavy.txt");
+    if (!saida.is_open()) {
+        std::cerr << "Erro ao criar arquivo de saída: saida_heavy.txt" << std::endl;
+        return;
+    }
+
+    // Elementos cuja contagem menos o erro já supera N / K são garantidamente frequentes.
+    size_t garantidos = 0;
+    for (const auto& e : elementos) {
+        if (std::get<1>(e) - std::get<2>(e) > resumo.erroMaximo()) garantidos++;
+    }
+
+    saida << "A ESTRUTURA SPACE-SAVING TEM AS SEGUINTES INFORMAÇÕES: \n";
+    saida << "tempo de montagem: " << duracao_ns << " nanosegundos (" << std::fixed << std::setprecision(9) << duracao_s << " segundos)\n";
+    saida << "contadores (K): " << resumo.capacidade() << "\n";
+    saida << "total de palavras (N): " << resumo.total() << "\n";
+    saida << "erro máximo por contagem (N/K): " << resumo.erroMaximo() << "\n";
+    saida << "palavras monitoradas: " << resumo.monitorados() << " (" << garantidos << " garantidamente acima de N/K)\n";
+    contadores_hw.escrever(saida);
+    saida << "\n";
+
+    saida << std::left << std::setw(25) << "Palavra" << "Frequencia\n";
+    saida << "--------------------------------------\n";
+
+    for (const auto& p : vetor_palavras_frequencias) {
+        saida << std::left << std::setw(25) << p.first << p.second << "\n";
+    }
+
+    saida.close();
+    cronometro_escrita.parar();
+    if (metricas_ativas) {
+        metricas.salvar("saida_heavy", opcoes.formato_stats, "heavy", caminho_arquivo, duracao_ns, vetor_palavras_frequencias.size());
+    }
+    std::cout << "Arquivo 'saida_heavy.txt' gerado com sucesso!\n";
+}
+
+// Modo --estimate-distinct: apenas estima quantas palavras distintas o arquivo tem, sem montar dicionário.
+void processar_com_hll(const std::string& caminho_arquivo, size_t num_threads) {
+    HyperLogLog<std::string> sketch;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    if (!estimar_distintas(caminho_arquivo, num_threads, sketch)) return;
+    double estimativa = sketch.estimate();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    long long duracao_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double duracao_s = static_cast<double>(duracao_ns) / 1e9;
+
+    std::ofstream saida("saida_hll.txt");
+    if (!saida.is_open()) {
+        std::cerr << "Erro ao criar arquivo de saída: saida_hll.txt" << std::endl;
+        return;
+    }
+
+    saida << "A ESTIMATIVA HYPERLOGLOG TEM AS SEGUINTES INFORMAÇÕES: \n";
+    saida << "tempo de estimativa: " << duracao_ns << " nanosegundos (" << std::fixed << std::setprecision(9) << duracao_s << " segundos)\n";
+    saida << "palavras distintas (estimativa): " << std::setprecision(0) << estimativa << "\n";
+    saida << "erro padrão relativo: " << std::setprecision(2) << sketch.erroPadrao() * 100.0 << "%\n";
+    saida << "precisão (p): " << sketch.precisao() << "\n";
+    saida << "representação: " << (sketch.esparso() ? "esparsa" : "densa") << "\n";
+    saida << "memória do sketch: " << sketch.memoriaBytes() << " bytes\n";
+    saida << "threads: " << std::max<size_t>(num_threads, 1) << "\n";
+
+    saida.close();
+    std::cout << "Palavras distintas (estimativa): " << std::fixed << std::setprecision(0) << estimativa << "\n";
+    std::cout << "Arquivo 'saida_hll.txt' gerado com sucesso!\n";
+}
+
+// Resultado de um arquivo no modo lote (para --per-file-stats).
+struct ResultadoArquivo {
+    bool lido = false;
+    size_t palavras = 0;
+    long long duracao_ns = 0;
+    size_t trabalhador = 0; // Thread que contou o arquivo
+};
+
+// Modo lote: vários arquivos (diretórios são percorridos recursivamente) contados por um conjunto
+// de threads. Cada thread tem o seu Dicionario e pega o próximo arquivo livre; no fim os pares de
+// todas são mesclados, somando as frequências, em um único saida_<nome>.txt.
+// Usa a interface de contagem localizar_ou_inserir/incrementar (avl, rb, chained e open).
+// 'contadores(dicionario)' devolve {comparações, rotações ou rehashes}, somados entre as threads
+// e escritos com 'rotulo_comparacoes' e 'rotulo_reestruturacoes'.
+template <typename Stats, typename Chave, typename Dicionario, typename Contadores>
+void processar_lote(const std::vector<std::string>& arquivos, const OpcoesExecucao& opcoes, const std::string& nome,
+                    const char* titulo, const char* rotulo_comparacoes, const char* rotulo_reestruturacoes,
+                    Contadores contadores) {
+    size_t num_trabalhadores = threads_do_lote(opcoes.num_trabalhadores, arquivos.size());
+    std::vector<Dicionario> dicionarios(num_trabalhadores);
+    std::vector<ResultadoArquivo> resultados(arquivos.size());
+
+    auto start = std::chrono::high_resolution_clock::now();
+    executar_em_lote(arquivos.size(), num_trabalhadores, [&](size_t trabalhador, size_t i) {
+        Dicionario& dicionario = dicionarios[trabalhador];
+        ResultadoArquivo& resultado = resultados[i];
+        auto inicio_arquivo = std::chrono::high_resolution_clock::now();
+        resultado.lido = percorrer_entrada(arquivos[i], opcoes, [&](const std::string& palavra) {
+            const Chave& limpa = palavra; // Converte uma vez (com std::string é só uma referência)
+            dicionario.incrementar(dicionario.localizar_ou_inserir(limpa)); // Uma só busca por palavra
+            resultado.palavras++;
+        });
+        resultado.duracao_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now() - inicio_arquivo).count();
+        resultado.trabalhador = trabalhador;
+    });
+    auto end = std::chrono::high_resolution_clock::now();
+
+    // Mescla: junta os pares das threads, ordena pela chave e soma as frequências repetidas.
+    std::vector<std::pair<Chave, int>> vetor_palavras_frequencias;
+    long long comparacoes = 0;
+    long long reestruturacoes = 0;
+    {
+        std::vector<std::pair<Chave, int>> parcial;
+        for (const Dicionario& dicionario : dicionarios) {
+            dicionario.getAllPairs(parcial);
+            vetor_palavras_frequencias.insert(vetor_palavras_frequencias.end(),
+                                              std::make_move_iterator(parcial.begin()), std::make_move_iterator(parcial.end()));
+            auto [c, r] = contadores(dicionario);
+            comparacoes += c;
+            reestruturacoes += r;
+        }
+        std::sort(vetor_palavras_frequencias.begin(), vetor_palavras_frequencias.end(),
+                  [](const std::pair<Chave, int>& a, const std::pair<Chave, int>& b) {
+                      return a.first < b.first;
+                  });
+        size_t destino = 0;
+        for (size_t i = 0; i < vetor_palavras_frequencias.size(); ++i) {
+            if (destino > 0 && vetor_palavras_frequencias[destino - 1].first == vetor_palavras_frequencias[i].first) {
+                vetor_palavras_frequencias[destino - 1].second += vetor_palavras_frequencias[i].second;
+            } else {
+                if (destino != i) vetor_palavras_frequencias[destino] = std::move(vetor_palavras_frequencias[i]);
+                destino++;
+            }
+        }
+        vetor_palavras_frequencias.resize(destino);
+    }
+    auto end_mescla = std::chrono::high_resolution_clock::now();
+
+    long long duracao_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double duracao_s = static_cast<double>(duracao_ns) / 1e9;
+    long long mescla_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end_mescla - end).count();
+    size_t lidos = std::count_if(resultados.begin(), resultados.end(), [](const ResultadoArquivo& r) { return r.lido; });
+
+    std::string arquivo_saida = "saida_" + nome + ".txt";
+    std::ofstream saida(arquivo_saida);
+    if (!saida.is_open()) {
+        std::cerr << "Erro ao criar arquivo de saída: " << arquivo_saida << std::endl;
+        return;
+    }
+
+    saida << "A ESTRUTURA " << titulo << " TEM AS SEGUINTES INFORMAÇÕES (MODO LOTE): \n";
+    saida << "arquivos lidos: " << lidos << " de " << arquivos.size() << "\n";
+    saida << "threads: " << num_trabalhadores << "\n";
+    saida << "tempo de montagem: " << duracao_ns << " nanosegundos (" << std::fixed << std::setprecision(9) << duracao_s << " segundos)\n";
+    saida << "tempo de mesclagem: " << mescla_ns << " nanosegundos\n";
+    escrever_contador<Stats>(saida, rotulo_comparacoes, comparacoes);
+    escrever_contador<Stats>(saida, rotulo_reestruturacoes, reestruturacoes);
+    saida << "\n";
+
+    saida << std::left << std::setw(25) << "Palavra" << "Frequencia\n";
+    saida << "--------------------------------------\n";
+
+    for (const auto& p : vetor_palavras_frequencias) {
+        saida << std::left << std::setw(25) << p.first << p.second << "\n";
+    }
+    saida.close();
+
+    if (opcoes.estatisticas_arquivos) {
+        std::string arquivo_stats = "saida_" + nome + "_arquivos.txt";
+        std::ofstream stats(arquivo_stats);
+        if (!stats.is_open()) {
+            std::cerr << "Erro ao criar arquivo de saída: " << arquivo_stats << std::endl;
+            return;
+        }
+        stats << std::left << std::setw(12) << "Palavras" << std::setw(16) << "Tempo (ns)" << std::setw(8) << "Thread" << "Arquivo\n";
+        stats << "--------------------------------------\n";
+        for (size_t i = 0; i < arquivos.size(); ++i) {
+            const ResultadoArquivo& r = resultados[i];
+            if (r.lido) {
+                stats << std::left << std::setw(12) << r.palavras << std::setw(16) << r.duracao_ns << std::setw(8) << r.trabalhador;
+            } else {
+                stats << std::left << std::setw(36) << "(erro de leitura)";
+            }
+            stats << arquivos[i] << "\n";
+        }
+        std::cout << "Arquivo '" << arquivo_stats << "' gerado com sucesso!\n";
+    }
+    std::cout << "Arquivo '" << arquivo_saida << "' gerado com sucesso!\n";
+}
+
+// Modo --dump-tokens: lê e normaliza o arquivo uma vez e grava os tokens num arquivo binário
+// (ver arquivo_tokens.hpp). Com --tokens, as execuções seguintes leem esse arquivo direto, e o
+// tempo de montagem passa a medir só o trabalho dos dicionários.
+// Retorna false se a entrada não puder ser lida por inteiro ou o arquivo de tokens não puder ser
+// gravado; nesses casos um arquivo de tokens anterior em 'caminho_tokens' fica intacto.
+bool processar_dump_tokens(const std::string& caminho_arquivo, const std::string& caminho_tokens) {
+    GravadorTokens gravador(caminho_tokens);
+    if (!gravador.aberto()) {
+        std::cerr << "Erro ao criar arquivo de saída: " << caminho_tokens << std::endl;
+        return false;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    bool lido = percorrer_palavras(caminho_arquivo, [&](const std::string& limpa) { gravador.adicionar(limpa); });
+    if (!lido) {
+        gravador.descartar();
+        return false;
+    }
+    bool gravado = gravador.fechar();
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!gravado) {
+        std::cerr << "Erro ao gravar arquivo de tokens: " << caminho_tokens << std::endl;
+        return false;
+    }
+
+    double duracao_s = std::chrono::duration<double>(end - start).count();
+    std::cout << "Tokens gravados: " << gravador.tokens() << " (" << gravador.bytes() << " bytes, "
+              << std::fixed << std::setprecision(3) << duracao_s << " segundos)\n";
+    std::cout << "Arquivo '" << caminho_tokens << "' gerado com sucesso!\n";
+    return true;
 }
 
 // Main Principal do Programa (Ponto de Entrada)
 
+// Converte o valor numérico de uma opção (ex.: "--width 4096"); retorna false se for inválido.
+// Só dígitos: stoull aceitaria espaços e sinal ("-1" viraria 2^64 - 1). Zero só com 'aceita_zero'.
+bool ler_opcao_numerica(const std::string& texto, size_t& destino, bool aceita_zero = false) {
+    if (texto.empty() || texto.find_first_not_of("0123456789") != std::string::npos) return false;
+    try {
+        size_t lidos = 0;
+        unsigned long long valor = std::stoull(texto, &lidos);
+        if (lidos != texto.size() || (valor == 0 && !aceita_zero)) return false;
+        destino = static_cast<size_t>(valor);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+// Chama 'processar(stats, chave)' com objetos dos tipos escolhidos nas opções:
+// NullStats com --no-stats (senão CountingStats) e ChaveCurta com --short-keys (senão std::string).
+template <typename Funcao>
+void despachar(const OpcoesExecucao& opcoes, Funcao&& processar) {
+    if (opcoes.sem_estatisticas) {
+        if (opcoes.chaves_curtas) processar(NullStats{}, ChaveCurta{});
+        else processar(NullStats{}, std::string{});
+    } else {
+        if (opcoes.chaves_curtas) processar(CountingStats{}, ChaveCurta{});
+        else processar(CountingStats{}, std::string{});
+    }
+}
+
+// Modo lote: escolhe o dicionário de 'estrutura' (e as variantes das opções) para processar_lote.
+// Retorna false se a estrutura não tiver modo lote.
+bool processar_em_lote(const std::string& estrutura, const std::vector<std::string>& arquivos, const OpcoesExecucao& opcoes) {
+    auto comparacoes_e_rotacoes = [](const auto& d) { return std::make_pair<long long, long long>(d.getComparacoesPrincipais(), d.getRotacoes()); };
+    // As árvores só contam os desempates além do prefixo de 8 bytes (como na saída de um arquivo).
+    const char* rotulo_desempates = "número de comparações de chaves (desempates além do prefixo de 8 bytes, soma das threads)";
+    const char* rotulo_comparacoes = "número de comparações de chaves (soma das threads)";
+    if (estrutura == "avl") {
+        despachar(opcoes, [&](auto stats, auto chave) {
+            using S = decltype(stats);
+            using C = decltype(chave);
+            processar_lote<S, C, DicionarioAvl<C, int, S>>(arquivos, opcoes, "avl", "AVL", rotulo_desempates, "número de rotações (soma das threads)", comparacoes_e_rotacoes);
+        });
+    } else if (estrutura == "rb") {
+        despachar(opcoes, [&](auto stats, auto chave) {
+            using S = decltype(stats);
+            using C = decltype(chave);
+            processar_lote<S, C, DicionarioRb<C, int, S>>(arquivos, opcoes, "rb", "RUBRO-NEGRA", rotulo_desempates, "número de rotações (soma das threads)", comparacoes_e_rotacoes);
+        });
+    } else if (estrutura == "chained") {
+        despachar(opcoes, [&](auto stats, auto chave) {
+            using S = decltype(stats);
+            using C = decltype(chave);
+            auto contadores = [](const auto& d) { return std::make_pair<long long, long long>(d.getComparacoesPrincipal(), d.getContadorRehash()); };
+            const char* rotulo = "número de rehashes (soma das threads)";
+            if (opcoes.ordem_cadeias == MoverParaFrente::nome)
+                processar_lote<S, C, DicionarioChained<C, int, MoverParaFrente, S>>(arquivos, opcoes, "chained", "HASH ENCADEADA", rotulo_comparacoes, rotulo, contadores);
+            else if (opcoes.ordem_cadeias == Transpor::nome)
+                processar_lote<S, C, DicionarioChained<C, int, Transpor, S>>(arquivos, opcoes, "chained", "HASH ENCADEADA", rotulo_comparacoes, rotulo, contadores);
+            else
+                processar_lote<S, C, DicionarioChained<C, int, OrdemInsercao, S>>(arquivos, opcoes, "chained", "HASH ENCADEADA", rotulo_comparacoes, rotulo, contadores);
+        });
+    } else if (estrutura == "open") {
+        despachar(opcoes, [&](auto stats, auto chave) {
+            using S = decltype(stats);
+            using C = decltype(chave);
+            auto contadores = [](const auto& d) { return std::make_pair<long long, long long>(d.getComparacoesPrincipais(), d.getContadorRehash()); };
+            processar_lote<S, C, DicionarioOpen<C, int, S>>(arquivos, opcoes, "open", "HASH ABERTO", rotulo_comparacoes, "número de rehashes (soma das threads)", contadores);
+        });
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// processar_com_chained com a política das cadeias escolhida em --chain-order.
+template <typename Stats, typename Chave>
+ResumoExecucao processar_com_chained_ordem(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes) {
+    if (opcoes.ordem_cadeias == MoverParaFrente::nome) return processar_com_chained<Stats, Chave, MoverParaFrente>(caminho_arquivo, opcoes);
+    if (opcoes.ordem_cadeias == Transpor::nome) return processar_com_chained<Stats, Chave, Transpor>(caminho_arquivo, opcoes);
+    return processar_com_chained<Stats, Chave, OrdemInsercao>(caminho_arquivo, opcoes);
+}
+
+// Modo 'all': lê e normaliza o arquivo (ou lê o arquivo de --tokens) uma única vez num BufferTokens e monta, com os mesmos
+// tokens, os dicionários avl, rb, chained e open. As estruturas rodam uma depois da outra, para
+// que os tempos não disputem núcleos nem cache. Grava os quatro saida_<estrutura>.txt e a
+// tabela lado a lado em saida_comparacao.txt.
+void processar_com_todas(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes) {
+    BufferTokens tokens;
+    auto start = std::chrono::high_resolution_clock::now();
+    bool lido = percorrer_entrada(caminho_arquivo, opcoes, [&](const std::string& limpa) { tokens.adicionar(limpa); });
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!lido) return;
+    long long leitura_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    OpcoesExecucao opcoes_tokens = opcoes;
+    opcoes_tokens.tokens = &tokens;
+
+    struct Linha {
+        const char* estrutura;
+        ResumoExecucao resumo;
+    };
+    std::vector<Linha> linhas;
+    despachar(opcoes, [&](auto stats, auto chave) {
+        using S = decltype(stats);
+        using C = decltype(chave);
+        linhas.push_back({"avl", processar_com_avl<S, C>(caminho_arquivo, opcoes_tokens)});
+        linhas.push_back({"rb", processar_com_rb<S, C>(caminho_arquivo, opcoes_tokens)});
+        linhas.push_back({"chained", processar_com_chained_ordem<S, C>(caminho_arquivo, opcoes_tokens)});
+        linhas.push_back({"open", processar_com_open<S, C>(caminho_arquivo, opcoes_tokens)});
+    });
+
+    std::ofstream saida("saida_comparacao.txt");
+    if (!saida.is_open()) {
+        std::cerr << "Erro ao criar arquivo de saída: saida_comparacao.txt" << std::endl;
+        return;
+    }
+
+    saida << "A COMPARAÇÃO DAS ESTRUTURAS TEM AS SEGUINTES INFORMAÇÕES: \n";
+    saida << "tempo de leitura e normalização (uma vez para todas): " << leitura_ns << " nanosegundos ("
+          << std::fixed << std::setprecision(9) << static_cast<double>(leitura_ns) / 1e9 << " segundos)\n";
+    saida << "tokens: " << tokens.tokens() << " (" << tokens.bytes() << " bytes no buffer)\n";
+    saida << "reestruturações: rotações nas árvores (avl, rb), rehashes nas tabelas (chained, open)\n";
+    // As árvores decidem a maioria das comparações pelo prefixo de 8 bytes guardado no nó e só
+    // contam os desempates que leem as chaves; as tabelas contam toda comparação de chave.
+    // Os dois números medem coisas diferentes, por isso ficam em colunas separadas.
+    saida << "desempates de prefixo: comparações das árvores (avl, rb) que foram além do prefixo de 8 bytes\n";
+    saida << "comparações de chave: todas as comparações de chave das tabelas (chained, open)\n";
+    saida << "\n";
+
+    // std::setw conta bytes: os cabeçalhos com 'ç' e 'õ' (2 bytes cada em UTF-8) recebem 2 colunas a mais.
+    saida << std::left << std::setw(12) << "Estrutura" << std::setw(18) << "Tempo (ns)" << std::setw(24) << "Desempates de prefixo"
+          << std::setw(26) << "Comparações de chave" << std::setw(20) << "Reestruturações" << "Distintas\n";
+    saida << "----------------------------------------------------------------------------------------------------------\n";
+    for (const Linha& linha : linhas) {
+        const ResumoExecucao& r = linha.resumo;
+        saida << std::left << std::setw(12) << linha.estrutura;
+        if (!r.concluido) {
+            saida << "(não concluída)\n";
+            continue;
+        }
+        saida << std::setw(18) << r.duracao_ns;
+        if (!r.contadores) saida << std::setw(24) << "-" << std::setw(24) << "-" << std::setw(18) << "-";
+        else if (r.so_desempates) saida << std::setw(24) << r.comparacoes << std::setw(24) << "-" << std::setw(18) << r.reestruturacoes;
+        else saida << std::setw(24) << "-" << std::setw(24) << r.comparacoes << std::setw(18) << r.reestruturacoes;
+        saida << r.distintas << "\n";
+    }
+
+    saida.close();
+    std::cout << "Arquivo 'saida_comparacao.txt' gerado com sucesso!\n";
+}
+
+// Modo 'ids': contagem em dois níveis. Cada palavra normalizada é resolvida para um id denso de
+// 32 bits pela tabela de internação (InternadorPalavras sobre o dicionário de --id-backend) e a
+// contagem é só o incremento de contagens[id] num std::vector<uint64_t>. No fim os ids são
+// trocados de volta pelas palavras para a exportação.
+// Os contadores do dicionário medem apenas a resolução palavra → id, o que permite comparar as
+// estruturas nesse papel. 'contadores(dicionario)' devolve {comparações, rotações ou rehashes},
+// escritos com 'rotulo_comparacoes' e 'rotulo_reestruturacoes'.
+template <typename Stats, typename Chave, typename Dicionario, typename Contadores>
+void processar_com_ids(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes,
+                       const char* rotulo_comparacoes, const char* rotulo_reestruturacoes, Contadores contadores) {
+    InternadorPalavras<Dicionario, Chave> internador;
+    std::vector<uint64_t> contagens; // contagens[id]
+
+    ContadoresHardware contadores_hw(opcoes.contadores_hw);
+    MetricasFases metricas;
+    MetricasFases* metricas_ativas = opcoes.formato_stats.empty() ? nullptr : &metricas;
+    auto start = std::chrono::high_resolution_clock::now();
+    contadores_hw.iniciar();
+    bool lido = percorrer_entrada(caminho_arquivo, opcoes, [&](const std::string& palavra) {
+        const Chave& limpa = palavra; // Converte uma vez (com std::string é só uma referência)
+        uint32_t id = internador.resolver(limpa);
+        if (id == contagens.size()) contagens.push_back(0); // Id novo: sempre o próximo
+        contagens[id]++;
+    }, metricas_ativas);
+    contadores_hw.parar();
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!lido) return;
+
+    long long duracao_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double duracao_s = static_cast<double>(duracao_ns) / 1e9;
+
+    // Junta ids e palavras: ordena os ids pela palavra para a saída em ordem alfabética.
+    std::vector<uint32_t> ids(contagens.size());
+    {
+        MetricasFases::Cronometro cronometro(metricas_ativas, MetricasFases::ORDENACAO);
+        for (size_t id = 0; id < ids.size(); ++id) ids[id] = static_cast<uint32_t>(id);
+        std::sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) {
+            return internador.palavra(a) < internador.palavra(b);
+        });
+    }
+
+    MetricasFases::Cronometro cronometro_escrita(metricas_ativas, MetricasFases::ESCRITA);
+    std::ofstream saida("saida_ids.txt");
+    if (!saida.is_open()) {
+        std::cerr << "Erro ao criar arquivo de saída: saida_ids.txt" << std::endl;
+        return;
+    }
+
+    auto [comparacoes, reestruturacoes] = contadores(internador.dicionario());
+    saida << "A CONTAGEM POR IDS TEM AS SEGUINTES INFORMAÇÕES: \n";
+    saida << "estrutura da resolução palavra → id: " << opcoes.estrutura_ids << "\n";
+    saida << "tempo de montagem: " << duracao_ns << " nanosegundos (" << std::fixed << std::setprecision(9) << duracao_s << " segundos)\n";
+    escrever_contador<Stats>(saida, rotulo_comparacoes, comparacoes);
+    escrever_contador<Stats>(saida, rotulo_reestruturacoes, reestruturacoes);
+    saida << "ids distintos: " << internador.size() << " (contagens: " << contagens.size() * sizeof(uint64_t) << " bytes)\n";
+    contadores_hw.escrever(saida);
+    saida << "\n";
+
+    saida << std::left << std::setw(25) << "Palavra" << "Frequencia\n";
+    saida << "--------------------------------------\n";
+
+    for (uint32_t id : ids) {
+        saida << std::left << std::setw(25) << internador.palavra(id) << contagens[id] << "\n";
+    }
+
+    saida.close();
+    cronometro_escrita.parar();
+    if (metricas_ativas) {
+        metricas.salvar("saida_ids", opcoes.formato_stats, "ids", caminho_arquivo, duracao_ns, ids.size());
+    }
+    std::cout << "Arquivo 'saida_ids.txt' gerado com sucesso!\n";
+}
+
+// Modo 'ids' com o dicionário de --id-backend (valores uint32_t: id + 1).
+void processar_com_ids_escolhido(const std::string& caminho_arquivo, const OpcoesExecucao& opcoes) {
+    auto comparacoes_e_rotacoes = [](const auto& d) { return std::make_pair<long long, long long>(d.getComparacoesPrincipais(), d.getRotacoes()); };
+    // As árvores só contam os desempates além do prefixo de 8 bytes (como na saída de um arquivo).
+    const char* rotulo_desempates = "número de comparações de chaves (resolução palavra → id, desempates além do prefixo de 8 bytes)";
+    const char* rotulo_comparacoes = "número de comparações de chaves (resolução palavra → id)";
+    despachar(opcoes, [&](auto stats, auto chave) {
+        using S = decltype(stats);
+        using C = decltype(chave);
+        if (opcoes.estrutura_ids == "avl") {
+            processar_com_ids<S, C, DicionarioAvl<C, uint32_t, S>>(caminho_arquivo, opcoes, rotulo_desempates, "número de rotações", comparacoes_e_rotacoes);
+        } else if (opcoes.estrutura_ids == "rb") {
+            processar_com_ids<S, C, DicionarioRb<C, uint32_t, S>>(caminho_arquivo, opcoes, rotulo_desempates, "número de rotações", comparacoes_e_rotacoes);
+        } else if (opcoes.estrutura_ids == "chained") {
+            auto contadores = [](const auto& d) { return std::make_pair<long long, long long>(d.getComparacoesPrincipal(), d.getContadorRehash()); };
+            processar_com_ids<S, C, DicionarioChained<C, uint32_t, OrdemInsercao, S>>(caminho_arquivo, opcoes, rotulo_comparacoes, "número de rehashes", contadores);
+        } else {
+            auto contadores = [](const auto& d) { return std::make_pair<long long, long long>(d.getComparacoesPrincipais(), d.getContadorRehash()); };
+            processar_com_ids<S, C, DicionarioOpen<C, uint32_t, S>>(caminho_arquivo, opcoes, rotulo_comparacoes, "número de rehashes", contadores);
+        }
+    });
+}
+
+void mostrar_uso(const char* programa) {
+    std::cerr << "Uso: " << programa << " <estrutura> [opções] <arquivo_entrada>\n";
+    std::cerr << "       " << programa << " <estrutura> [opções] <arquivo_ou_diretório>... (modo lote: avl, rb, chained, open)\n";
+    std::cerr << "Estruturas suportadas: 'avl', 'chained', 'open', 'robin', 'cuckoo', 'rb', 'splay', 'art', 'cms', 'heavy', 'all', 'ids'\n";
+    std::cerr << "       " << programa << " --estimate-distinct [--threads N] <arquivo_entrada>\n";
+    std::cerr << "       " << programa << " --dump-tokens <arquivo_entrada> [arquivo_tokens] (padrão saida_tokens.bin)\n";
+    std::cerr << "Opções do modo 'cms': --width W (padrão 65536), --depth D (padrão 4), --top K (padrão 100)\n";
+    std::cerr << "Opções do modo 'heavy': --top K (padrão 100)\n";
+    std::cerr << "Modo 'ids': palavra → id denso (32 bits) por um dicionário e contagem num vetor; --id-backend avl|rb|chained|open (padrão open)\n";
+    std::cerr << "Modo 'all': lê o arquivo uma vez e monta avl, rb, chained e open com os mesmos tokens (tabela em saida_comparacao.txt)\n";
+    std::cerr << "Opções das tabelas hash (chained, open, robin, cuckoo): --presize (dimensiona a tabela pela estimativa HyperLogLog)\n";
+    std::cerr << "                                                       --presize-sample (estimativa rápida por amostra do início do arquivo)\n";
+    std::cerr << "                                                       --hash-stats (histogramas de sondagem, cadeias e slots removidos)\n";
+    std::cerr << "Opção de 'chained': --chain-order insertion|mtf|transpose (reordena a cadeia quando a chave é encontrada)\n";
+    std::cerr << "Opções de 'avl', 'rb' e 'splay': --tree-stats (altura, nós por nível e caminho de busca ponderado pela frequência)\n";
+    std::cerr << "--threads N: threads usadas pelo HyperLogLog (padrão 1)\n";
+    std::cerr << "Opções do modo lote (vários arquivos ou um diretório, percorrido recursivamente; uma saida_<estrutura>.txt mesclada):\n";
+    std::cerr << "    --workers N (threads contando arquivos, padrão uma por núcleo), --per-file-stats (grava saida_<estrutura>_arquivos.txt)\n";
+    std::cerr << "--no-stats: usa as estruturas sem contadores de comparações/rotações/rehashes (variante de produção)\n";
+    std::cerr << "--cache N: cache de N tokens recentes (2 vias) na frente de avl, rb, chained e open (também em 'all'); acertos só incrementam o contador\n";
+    std::cerr << "--short-keys: chaves ChaveCurta (até 24 bytes sem alocação) em avl, rb, splay e nas tabelas hash\n";
+    std::cerr << "--perf: mede ciclos, instruções e falhas de cache/TLB/desvio da montagem (perf_event_open)\n";
+    std::cerr << "--stats-format json|csv: grava o tempo de cada fase, vazão e pico de memória em saida_<estrutura>.<formato>\n";
+    std::cerr << "--tokens: a entrada é um arquivo de tokens de --dump-tokens (sem leitura de texto nem normalização ICU)\n";
+    std::cerr << "Arquivos .gz são reconhecidos e descompactados durante a leitura (sem arquivo temporário)\n";
+    std::cerr << "Exemplo: " << programa << " avl texto.txt\n";
+    std::cerr << "Exemplo: " << programa << " cms --width 4096 --depth 5 texto.txt\n";
+}
+
 int main(int argc, char* argv[]) {
     // 1. Validação dos Argumentos da Linha de Comando
-    // Esperamos: ./freq <estrutura> <arquivo_entrada>
-    if (argc != 3) {
-        std::cerr << "Uso: " << argv[0] << " <estrutura> <arquivo_entrada>\n";
-        std::cerr << "Estruturas suportadas: 'avl', 'chained', 'open', 'rb'\n";
-        std::cerr << "Exemplo: " << argv[0] << " avl texto.txt\n";
+    // Esperamos: ./freq <estrutura> [opções] <arquivo_entrada>
+    if (argc < 3) {
+        mostrar_uso(argv[0]);
         return 1; // Retorna código de erro
     }
 
-    std::string estrutura_arg = argv[1];    // "avl", "chained", "open", "rb"
-    std::string caminho_arquivo_arg = argv[2]; // "texto.txt"
+    std::string estrutura_arg = argv[1];    // "avl", "chained", "open", "robin", "cuckoo", "rb", "splay", "art", "cms", "heavy", "all", "ids" ou "--estimate-distinct"
+    std::vector<std::string> entradas_arg;  // "texto.txt" (ou vários arquivos/diretórios no modo lote)
+    OpcoesExecucao opcoes;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t* destino = nullptr;
+        if (arg == "--width") destino = &opcoes.largura_cms;
+        else if (arg == "--depth") destino = &opcoes.profundidade_cms;
+        else if (arg == "--top") destino = &opcoes.top_k;
+        else if (arg == "--threads") destino = &opcoes.num_threads;
+        else if (arg == "--cache") destino = &opcoes.entradas_cache;
+        else if (arg == "--workers") destino = &opcoes.num_trabalhadores;
+
+        if (destino) {
+            bool aceita_zero = (arg == "--cache"); // --cache 0 desliga o cache
+            if (i + 1 >= argc || !ler_opcao_numerica(argv[i + 1], *destino, aceita_zero)) {
+                std::cerr << "Erro: a opção '" << arg << "' espera um número "
+                          << (aceita_zero ? "não negativo" : "positivo") << ".\n";
+                return 1;
+            }
+            ++i;
+        } else if (arg == "--presize") {
+            opcoes.pre_dimensionar = true;
+        } else if (arg == "--presize-sample") {
+            opcoes.pre_dimensionar_amostra = true;
+        } else if (arg == "--perf") {
+            opcoes.contadores_hw = true;
+        } else if (arg == "--hash-stats") {
+            opcoes.estatisticas_hash = true;
+        } else if (arg == "--tree-stats") {
+            opcoes.estatisticas_arvore = true;
+        } else if (arg == "--no-stats") {
+            opcoes.sem_estatisticas = true;
+        } else if (arg == "--id-backend") {
+            std::string estrutura = (i + 1 < argc) ? argv[i + 1] : "";
+            if (estrutura != "avl" && estrutura != "rb" && estrutura != "chained" && estrutura != "open") {
+                std::cerr << "Erro: a opção '--id-backend' espera 'avl', 'rb', 'chained' ou 'open'.\n";
+                return 1;
+            }
+            opcoes.estrutura_ids = argv[++i];
+        } else if (arg == "--tokens") {
+            opcoes.entrada_tokens = true;
+        } else if (arg == "--per-file-stats") {
+            opcoes.estatisticas_arquivos = true;
+        } else if (arg == "--short-keys") {
+            opcoes.chaves_curtas = true;
+        } else if (arg == "--chain-order") {
+            std::string ordem = (i + 1 < argc) ? argv[i + 1] : "";
+            if (ordem != OrdemInsercao::nome && ordem != MoverParaFrente::nome && ordem != Transpor::nome) {
+                std::cerr << "Erro: a opção '--chain-order' espera 'insertion', 'mtf' ou 'transpose'.\n";
+                return 1;
+            }
+            opcoes.ordem_cadeias = argv[++i];
+        } else if (arg == "--stats-format") {
+            if (i + 1 >= argc || (std::string(argv[i + 1]) != "json" && std::string(argv[i + 1]) != "csv")) {
+                std::cerr << "Erro: a opção '--stats-format' espera 'json' ou 'csv'.\n";
+                return 1;
+            }
+            opcoes.formato_stats = argv[++i];
+        } else if (arg.rfind("--", 0) == 0) {
+            std::cerr << "Erro: argumento inesperado '" << arg << "'.\n";
+            mostrar_uso(argv[0]);
+            return 1;
+        } else {
+            entradas_arg.push_back(arg);
+        }
+    }
+
+    if (entradas_arg.empty()) {
+        mostrar_uso(argv[0]);
+        return 1;
+    }
+
+    if (estrutura_arg == "--dump-tokens") {
+        if (entradas_arg.size() > 2 || opcoes.entrada_tokens) {
+            mostrar_uso(argv[0]);
+            return 1;
+        }
+        bool gerado = processar_dump_tokens(entradas_arg[0], entradas_arg.size() == 2 ? entradas_arg[1] : "saida_tokens.bin");
+        return gerado ? 0 : 1;
+    }
+    if (estrutura_arg == "--estimate-distinct" && opcoes.entrada_tokens) {
+        std::cerr << "Erro: '--estimate-distinct' lê o arquivo de texto; a opção '--tokens' não se aplica.\n";
+        return 1;
+    }
+    // O CacheRecente precisa da interface de contagem (Posicao, localizar_ou_inserir, versao),
+    // que só os dicionários avl, rb, chained e open oferecem.
+    if (opcoes.entradas_cache && estrutura_arg != "avl" && estrutura_arg != "rb" && estrutura_arg != "chained" &&
+        estrutura_arg != "open" && estrutura_arg != "all") {
+        std::cerr << "Erro: a opção '--cache' só se aplica a 'avl', 'rb', 'chained', 'open' e 'all'.\n";
+        return 1;
+    }
+
+    // Vários caminhos ou um diretório: modo lote, com uma única saída mesclada.
+    if (entradas_arg.size() > 1 || std::filesystem::is_directory(entradas_arg[0])) {
+        // Cache, métricas por fase e estatísticas de forma são medidas de um dicionário só;
+        // o lote tem um por thread e não as produz.
+        const char* nao_suportada = nullptr;
+        if (opcoes.entradas_cache) nao_suportada = "--cache";
+        else if (!opcoes.formato_stats.empty()) nao_suportada = "--stats-format";
+        else if (opcoes.estatisticas_hash) nao_suportada = "--hash-stats";
+        else if (opcoes.estatisticas_arvore) nao_suportada = "--tree-stats";
+        if (nao_suportada) {
+            std::cerr << "Erro: a opção '" << nao_suportada << "' não se aplica ao modo lote (vários arquivos ou diretório).\n";
+            return 1;
+        }
+        std::vector<std::string> arquivos;
+        if (!listar_arquivos(entradas_arg, arquivos)) return 1;
+        if (arquivos.empty()) {
+            std::cerr << "Erro: nenhum arquivo encontrado nas entradas.\n";
+            return 1;
+        }
+        if (!processar_em_lote(estrutura_arg, arquivos, opcoes)) {
+            std::cerr << "Erro: o modo lote (vários arquivos ou diretório) suporta 'avl', 'rb', 'chained' e 'open'.\n";
+            return 1;
+        }
+        return 0;
+    }
+    const std::string& caminho_arquivo_arg = entradas_arg[0];
 
     // Despacho para a Função de Processamento Correta Baseada na Estrutura
     if (estrutura_arg == "avl") {
-        processar_com_avl(caminho_arquivo_arg);
+        despachar(opcoes, [&](auto stats, auto chave) {
+            processar_com_avl<decltype(stats), decltype(chave)>(caminho_arquivo_arg, opcoes);
+        });
     } else if (estrutura_arg == "chained") {
-        processar_com_chained(caminho_arquivo_arg);
+        despachar(opcoes, [&](auto stats, auto chave) {
+            processar_com_chained_ordem<decltype(stats), decltype(chave)>(caminho_arquivo_arg, opcoes);
+        });
     } else if (estrutura_arg == "open") {
-        processar_com_open(caminho_arquivo_arg);
+        despachar(opcoes, [&](auto stats, auto chave) {
+            processar_com_open<decltype(stats), decltype(chave)>(caminho_arquivo_arg, opcoes);
+        });
+    } else if (estrutura_arg == "robin") {
+        despachar(opcoes, [&](auto stats, auto chave) {
+            processar_com_robin<decltype(stats), decltype(chave)>(caminho_arquivo_arg, opcoes);
+        });
+    } else if (estrutura_arg == "cuckoo") {
+        despachar(opcoes, [&](auto stats, auto chave) {
+            processar_com_cuckoo<decltype(stats), decltype(chave)>(caminho_arquivo_arg, opcoes);
+        });
     } else if (estrutura_arg == "rb") {
-        processar_com_rb(caminho_arquivo_arg);
+        despachar(opcoes, [&](auto stats, auto chave) {
+            processar_com_rb<decltype(stats), decltype(chave)>(caminho_arquivo_arg, opcoes);
+        });
+    } else if (estrutura_arg == "splay") {
+        despachar(opcoes, [&](auto stats, auto chave) {
+            processar_com_splay<decltype(stats), decltype(chave)>(caminho_arquivo_arg, opcoes);
+        });
+    } else if (estrutura_arg == "art") {
+        if (opcoes.sem_estatisticas) processar_com_art<NullStats>(caminho_arquivo_arg, opcoes);
+        else processar_com_art<CountingStats>(caminho_arquivo_arg, opcoes);
+    } else if (estrutura_arg == "ids") {
+        processar_com_ids_escolhido(caminho_arquivo_arg, opcoes);
+    } else if (estrutura_arg == "all") {
+        processar_com_todas(caminho_arquivo_arg, opcoes);
+    } else if (estrutura_arg == "cms") {
+        processar_com_cms(caminho_arquivo_arg, opcoes);
+    } else if (estrutura_arg == "heavy") {
+        processar_com_heavy(caminho_arquivo_arg, opcoes);
+    } else if (estrutura_arg == "--estimate-distinct") {
+        processar_com_hll(caminho_arquivo_arg, opcoes.num_threads);
     } else {
         std::cerr << "Erro: Estrutura '" << estrutura_arg << "' não suportada.\n";
-        std::cerr << "Estruturas suportadas: 'avl', 'chained', 'open', 'rb'\n";
+        std::cerr << "Estruturas suportadas: 'avl', 'chained', 'open', 'robin', 'cuckoo', 'rb', 'splay', 'art', 'cms', 'heavy', 'all', 'ids'\n";
         return 1;
     }
 
     return 0;
-}
\ No newline at end of file
+}
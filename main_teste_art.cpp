@@ -0,0 +1,98 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+
+#include <unicode/unistr.h>
+#include <unicode/uchar.h>
+
+#include "dicionarioart.hpp"
+
+// Função para limpar e converter palavra para minúsculo (Unicode-safe)
+std::string limpar_e_minusculo(const std::string& palavra) {
+    icu::UnicodeString unicodePalavra = icu::UnicodeString::fromUTF8(palavra);
+    icu::UnicodeString unicodeLimpa;
+
+    for (int32_t i = 0; i < unicodePalavra.length(); ) {
+        UChar32 c = unicodePalavra.char32At(i);
+        if (u_isalpha(c)) {
+            unicodeLimpa.append(c);
+        }
+        i += U16_LENGTH(c);
+    }
+
+    unicodeLimpa.toLower();
+    std::string resultado;
+    unicodeLimpa.toUTF8String(resultado);
+    return resultado;
+}
+
+// Função para ler o arquivo de entrada e preencher o dicionário
+template <typename Dicionario>
+void ler_arquivo_e_inserir(const std::string& caminho, Dicionario& dicionario) {
+    std::ifstream arquivo(caminho);
+    if (!arquivo.is_open()) {
+        std::cerr << "Erro ao abrir arquivo: " << caminho << std::endl;
+        return;
+    }
+
+    std::string linha;
+    while (std::getline(arquivo, linha)) {
+        std::istringstream iss(linha);
+        std::string palavra;
+        while (iss >> palavra) {
+            std::string limpa = limpar_e_minusculo(palavra);
+            if (!limpa.empty()) {
+                int atual = dicionario.count(limpa);
+                dicionario.add(limpa, atual + 1);
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3 || argc > 4) {
+        std::cout << "Uso: " << argv[0] << " <arquivo_entrada.txt> <arquivo_saida.txt> [prefixo]\n";
+        return 1;
+    }
+
+    std::string caminho_entrada = argv[1];
+    std::string caminho_saida = argv[2];
+
+    DicionarioArt<std::string, int> dicionario;
+
+    // Cronômetro
+    auto start = std::chrono::high_resolution_clock::now();
+    ler_arquivo_e_inserir(caminho_entrada, dicionario);
+    auto end = std::chrono::high_resolution_clock::now();
+    long long duracao = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    std::ofstream saida(caminho_saida);
+    if (!saida.is_open()) {
+        std::cerr << "Erro ao criar arquivo de saída.\n";
+        return 1;
+    }
+
+    // Estatísticas
+    saida << "A ESTRUTURA TEM AS SEGUINTES INFORMAÇÕES: \n";
+    saida << "Tempo de execução: " << duracao << " nanosegundos\n";
+    saida << "Número de comparações de chaves: " << dicionario.getComparacoesPrincipais() << "\n";
+    saida << "Número de crescimentos de nós: " << dicionario.getCrescimentos() << "\n\n";
+
+    // Tabela de palavras (já em ordem alfabética), ou apenas as que começam com o prefixo informado
+    saida << std::left << std::setw(25) << "Palavra" << "Frequência\n";
+    saida << "--------------------------------------\n";
+
+    std::vector<std::pair<std::string, int>> pares =
+        (argc == 4) ? dicionario.getAllWithPrefix(argv[3]) : dicionario.getAllOrdered();
+
+    for (const auto& p : pares) {
+        saida << std::left << std::setw(25) << p.first << p.second << "\n";
+    }
+
+    std::cout << "Arquivo '" << caminho_saida << "' gerado com sucesso!\n";
+    return 0;
+}
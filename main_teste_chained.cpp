@@ -6,6 +6,8 @@
 #include <iomanip> // std::setw
 #include <vector>  // Para std::vector
 #include <algorithm> // Para std::sort
+#include <random>    // Para a carga Zipf sintética
+#include <cmath>     // Para std::pow
 
 // Inclua as bibliotecas Unicode se você as tiver configuradas.
 // Se não tiver, pode comentar estas linhas e usar uma versão mais simples de limpeza de string.
@@ -61,7 +63,82 @@ void ler_arquivo_e_inserir(const std::string& caminho, Dicionario& dicionario) {
     }
 }
 
-int main() {
+// Gera 'total' tokens sobre 'distintas' palavras com frequência de Zipf (a de posto r sai com
+// probabilidade proporcional a 1 / r^s). As palavras recebem nomes aleatórios e o posto não tem
+// relação com a ordem de inserção: uma palavra quente pode aparecer depois de várias frias.
+std::vector<std::string> gerar_tokens_zipf(size_t distintas, size_t total, double s, unsigned semente) {
+    std::mt19937_64 gerador(semente);
+    std::vector<std::string> palavras(distintas);
+    for (auto& palavra : palavras) {
+        palavra.resize(4 + gerador() % 8);
+        for (auto& c : palavra) c = static_cast<char>('a' + gerador() % 26);
+    }
+    std::vector<double> pesos(distintas);
+    for (size_t r = 0; r < distintas; ++r) pesos[r] = 1.0 / std::pow(static_cast<double>(r + 1), s);
+    std::discrete_distribution<size_t> posto(pesos.begin(), pesos.end());
+
+    std::vector<std::string> tokens(total);
+    for (auto& token : tokens) token = palavras[posto(gerador)];
+    return tokens;
+}
+
+// Conta as frequências dos tokens com a política de reordenação dada e retorna as
+// comparações de chave feitas pelo 'add' (o mesmo contador do modo chained).
+template <typename Reordenacao>
+long long comparacoes_com_politica(const std::vector<std::string>& tokens, float fator_carga) {
+    DicionarioChained<std::string, int, Reordenacao> dicionario(19, fator_carga);
+    for (const auto& token : tokens) {
+        int atual = dicionario.count(token);
+        dicionario.add(token, atual + 1);
+    }
+    return dicionario.getComparacoesPrincipal();
+}
+
+// Benchmark das políticas de reordenação das cadeias em carga Zipf (opção --zipf-bench).
+// Os formatos do fluxo (std::fixed, precisão) são restaurados no fim.
+void escrever_benchmark_zipf(std::ostream& saida) {
+    const size_t distintas = 50000;
+    const size_t total = 2000000;
+    std::ios::fmtflags formato = saida.flags();
+    std::streamsize precisao = saida.precision();
+    saida << std::defaultfloat;
+    saida << "Reordenação das cadeias em carga Zipf (" << distintas << " palavras, " << total << " tokens):\n";
+    saida << std::left << std::setw(10) << "s" << std::setw(14) << "carga máx." << std::setw(16) << "insertion"
+          << std::setw(16) << "mtf" << std::setw(16) << "transpose" << "\n";
+    for (double s : {0.8, 1.0, 1.2}) {
+        std::vector<std::string> tokens = gerar_tokens_zipf(distintas, total, s, 42);
+        for (float carga : {1.0f, 4.0f}) {
+            long long base = comparacoes_com_politica<OrdemInsercao>(tokens, carga);
+            long long mtf = comparacoes_com_politica<MoverParaFrente>(tokens, carga);
+            long long transp = comparacoes_com_politica<Transpor>(tokens, carga);
+            auto reducao = [base](long long c) {
+                std::ostringstream texto;
+                texto << c << " (" << std::fixed << std::setprecision(1) << 100.0 * (base - c) / base << "%)";
+                return texto.str();
+            };
+            saida << std::left << std::setw(10) << s << std::setw(14) << carga << std::setw(16) << base
+                  << std::setw(16) << reducao(mtf) << std::setw(16) << reducao(transp) << "\n";
+        }
+    }
+    saida << "(percentual = redução das comparações em relação à ordem de inserção)\n";
+    saida.flags(formato);
+    saida.precision(precisao);
+}
+
+// Uso: main_teste_chained            conta as palavras do arquivo de exemplo (saida_chained.txt)
+//      main_teste_chained --zipf-bench  só o benchmark das políticas de reordenação (saida_chained_zipf.txt)
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--zipf-bench") {
+        std::ofstream saida_zipf("saida_chained_zipf.txt");
+        if (!saida_zipf.is_open()) {
+            std::cerr << "Erro ao criar arquivo de saída: saida_chained_zipf.txt" << std::endl;
+            return 1;
+        }
+        escrever_benchmark_zipf(saida_zipf);
+        std::cout << "Arquivo 'saida_chained_zipf.txt' gerado com sucesso!\n";
+        return 0;
+    }
+
     // Verifique o caminho do arquivo. Use um caminho absoluto ou relativo correto.
     std::string caminho = "/home/kelvy_lima/Documentos/TRABALHO FINAL DO ATILIO_alterado/exemplo.txt";
 
@@ -89,7 +166,9 @@ int main() {
     saida << "A ESTRUTURA TEM AS SEGUINTES INFORMAÇÕES: \n";
     saida << "tempo de montagem: " << duracao_ns << " nanosegundos (" << std::fixed << std::setprecision(9) << duracao_s << " segundos)\n";
     saida << "número de comparações de chaves: " << dicionario_chained.getComparacoesPrincipal() << "\n";
-    saida << "número de colisões (rehash): " << dicionario_chained.getContadorRehash() << "\n\n";
+    saida << "número de colisões (rehash): " << dicionario_chained.getContadorRehash() << "\n";
+    dicionario_chained.estatisticas().escrever(saida);
+    saida << "\n";
 
     saida << std::left << std::setw(25) << "Palavra" << "Frequencia\n";
     saida << "--------------------------------------\n";
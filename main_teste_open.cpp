@@ -86,7 +86,9 @@ int main(int argc, char* argv[]) {
     saida << "A ESTRUTURA TEM AS SEGUINTES INFORMAÇÕES: \n";
     saida << "Tempo de execução: " << duracao << " nanosegundos\n";
     saida << "Número de comparações de chaves: " << dicionario.getComparacoesPrincipais() << "\n";
-    saida << "Número de colisões (rehash): " << dicionario.getContadorRehash() << "\n\n";
+    saida << "Número de colisões (rehash): " << dicionario.getContadorRehash() << "\n";
+    dicionario.estatisticas().escrever(saida);
+    saida << "\n";
 
     // Tabela de palavras ordenadas
     saida << std::left << std::setw(25) << "Palavra" << "Frequência\n";
@@ -0,0 +1,161 @@
+#ifndef METRICAS_FASES_HPP
+#define METRICAS_FASES_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// Tempo por fase de uma execução (leitura, tokenização, normalização, contagem, coleta,
+// ordenação e escrita), contadores de bytes/tokens, vazão e pico de memória residente.
+// O resultado é gravado em JSON ou CSV ao lado do arquivo de saída em texto.
+// A medição por token custa algumas leituras de relógio por palavra, por isso só é feita
+// quando a opção --stats-format é usada.
+class MetricasFases {
+public:
+    enum Fase { LEITURA, TOKENIZACAO, NORMALIZACAO, CONTAGEM, COLETA, ORDENACAO, ESCRITA, NUM_FASES };
+    using Relogio = std::chrono::steady_clock;
+
+    // Acumula o tempo do escopo em uma fase. Com métricas nulas não faz nada.
+    class Cronometro {
+    private:
+        MetricasFases* m_metricas;
+        Fase m_fase;
+        Relogio::time_point m_inicio;
+
+    public:
+        Cronometro(MetricasFases* metricas, Fase fase) : m_metricas(metricas), m_fase(fase) {
+            if (m_metricas) m_inicio = Relogio::now();
+        }
+        ~Cronometro() { parar(); }
+
+        // Encerra a medição antes do fim do escopo.
+        void parar() {
+            if (m_metricas) m_metricas->adicionar(m_fase, Relogio::now() - m_inicio);
+            m_metricas = nullptr;
+        }
+        Cronometro(const Cronometro&) = delete;
+        Cronometro& operator=(const Cronometro&) = delete;
+    };
+
+    uint64_t bytes = 0;    // Bytes lidos da entrada
+    uint64_t tokens = 0;   // Tokens separados por espaço (antes da normalização)
+    uint64_t palavras = 0; // Tokens que continuaram não vazios após a normalização
+
+    void adicionar(Fase fase, Relogio::duration duracao) {
+        m_ns[fase] += std::chrono::duration_cast<std::chrono::nanoseconds>(duracao).count();
+    }
+
+    long long nanossegundos(Fase fase) const { return m_ns[fase]; }
+
+    static const char* nome(Fase fase) {
+        switch (fase) {
+            case LEITURA:      return "leitura";
+            case TOKENIZACAO:  return "tokenizacao";
+            case NORMALIZACAO: return "normalizacao";
+            case CONTAGEM:     return "contagem";
+            case COLETA:       return "coleta";
+            case ORDENACAO:    return "ordenacao";
+            case ESCRITA:      return "escrita";
+            default:           return "?";
+        }
+    }
+
+    // Pico de memória residente do processo em KiB (0 se indisponível).
+    static long picoMemoriaKB() {
+#if defined(__unix__) || defined(__APPLE__)
+        rusage uso;
+        if (getrusage(RUSAGE_SELF, &uso) == 0) {
+#if defined(__APPLE__)
+            return uso.ru_maxrss / 1024; // macOS informa em bytes
+#else
+            return uso.ru_maxrss;
+#endif
+        }
+#endif
+        return 0;
+    }
+
+    // Grava as métricas em "<base>.json" ou "<base>.csv", conforme 'formato'.
+    // 'montagem_ns' é o tempo de montagem já reportado no arquivo texto.
+    bool salvar(const std::string& base, const std::string& formato, const std::string& estrutura,
+                const std::string& entrada, long long montagem_ns, size_t distintas) const {
+        std::string caminho = base + "." + formato;
+        std::ofstream saida(caminho);
+        if (!saida.is_open()) {
+            std::cerr << "Erro ao criar arquivo de métricas: " << caminho << std::endl;
+            return false;
+        }
+
+        double segundos = static_cast<double>(montagem_ns) / 1e9;
+        double mb_s = segundos > 0 ? static_cast<double>(bytes) / (1024.0 * 1024.0) / segundos : 0.0;
+        double tokens_s = segundos > 0 ? static_cast<double>(tokens) / segundos : 0.0;
+        long pico_kb = picoMemoriaKB();
+        saida << std::fixed << std::setprecision(3);
+
+        if (formato == "json") {
+            saida << "{\n";
+            saida << "  \"estrutura\": \"" << estrutura << "\",\n";
+            saida << "  \"arquivo\": \"" << escaparJson(entrada) << "\",\n";
+            saida << "  \"bytes\": " << bytes << ",\n";
+            saida << "  \"tokens\": " << tokens << ",\n";
+            saida << "  \"palavras\": " << palavras << ",\n";
+            saida << "  \"distintas\": " << distintas << ",\n";
+            saida << "  \"fases_ns\": {";
+            for (int f = 0; f < NUM_FASES; ++f)
+                saida << (f ? ", " : "") << "\"" << nome(static_cast<Fase>(f)) << "\": " << m_ns[f];
+            saida << "},\n";
+            saida << "  \"montagem_ns\": " << montagem_ns << ",\n";
+            saida << "  \"vazao_mb_s\": " << mb_s << ",\n";
+            saida << "  \"tokens_por_s\": " << tokens_s << ",\n";
+            saida << "  \"pico_rss_kb\": " << pico_kb << "\n";
+            saida << "}\n";
+        } else {
+            saida << "estrutura,arquivo,bytes,tokens,palavras,distintas";
+            for (int f = 0; f < NUM_FASES; ++f) saida << "," << nome(static_cast<Fase>(f)) << "_ns";
+            saida << ",montagem_ns,vazao_mb_s,tokens_por_s,pico_rss_kb\n";
+            saida << estrutura << ",\"" << escaparCsv(entrada) << "\"," << bytes << "," << tokens << "," << palavras << "," << distintas;
+            for (int f = 0; f < NUM_FASES; ++f) saida << "," << m_ns[f];
+            saida << "," << montagem_ns << "," << mb_s << "," << tokens_s << "," << pico_kb << "\n";
+        }
+        return true;
+    }
+
+private:
+    long long m_ns[NUM_FASES] = {};
+
+    // Aspas e barras invertidas ganham uma barra invertida; caracteres de controle (< 0x20) viram \u00XX.
+    static std::string escaparJson(const std::string& texto) {
+        static const char hex[] = "0123456789abcdef";
+        std::string result;
+        for (char c : texto) {
+            unsigned char u = static_cast<unsigned char>(c);
+            if (u < 0x20) {
+                result += "\\u00";
+                result += hex[u >> 4];
+                result += hex[u & 0xF];
+                continue;
+            }
+            if (c == '"' || c == '\\') result += '\\';
+            result += c;
+        }
+        return result;
+    }
+
+    static std::string escaparCsv(const std::string& texto) {
+        std::string result;
+        for (char c : texto) {
+            if (c == '"') result += '"';
+            result += c;
+        }
+        return result;
+    }
+};
+
+#endif // METRICAS_FASES_HPP
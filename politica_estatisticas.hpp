@@ -0,0 +1,43 @@
+#ifndef POLITICA_ESTATISTICAS_HPP
+#define POLITICA_ESTATISTICAS_HPP
+
+// Políticas de instrumentação usadas como parâmetro de template pelas estruturas
+// (Set, rbtree, ArtTree, ChainedHashTable, HashAberto e os dicionários).
+// Cada estrutura mede dois eventos:
+// - comparações de chave (ou nós visitados) nas buscas e inserções;
+// - reestruturações: rotações nas árvores, rehashes nas tabelas, crescimento de nós na ART.
+//
+// CountingStats conta como antes (é o padrão). NullStats tem corpo vazio em todos os
+// métodos: o compilador elimina as chamadas e os laços internos ficam sem nenhum acesso
+// a contador, útil para medições de produção ou para uso concorrente.
+
+struct CountingStats {
+    static constexpr bool ativo = true;
+
+    // 'const' porque buscas const também contam comparações.
+    void comparacao(long long n = 1) const { m_comparacoes += n; }
+    void reestruturacao(long long n = 1) { m_reestruturacoes += n; }
+
+    long long comparacoes() const { return m_comparacoes; }
+    long long reestruturacoes() const { return m_reestruturacoes; }
+    void resetComparacoes() { m_comparacoes = 0; }
+    void resetReestruturacoes() { m_reestruturacoes = 0; }
+
+private:
+    mutable long long m_comparacoes = 0;
+    long long m_reestruturacoes = 0;
+};
+
+struct NullStats {
+    static constexpr bool ativo = false;
+
+    void comparacao(long long = 1) const {}
+    void reestruturacao(long long = 1) {}
+
+    long long comparacoes() const { return 0; }
+    long long reestruturacoes() const { return 0; }
+    void resetComparacoes() {}
+    void resetReestruturacoes() {}
+};
+
+#endif // POLITICA_ESTATISTICAS_HPP
@@ -0,0 +1,84 @@
+#ifndef PREFIXO_CHAVE_HPP
+#define PREFIXO_CHAVE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+// Primeiros 8 bytes de uma chave de texto lidos em big-endian (completados com zeros) e o
+// tamanho da chave. Guardado nos nós das árvores (AVLNode e RBNode) ao lado da chave.
+struct PrefixoChave {
+    uint64_t bits = 0;
+    uint32_t tamanho = 0;
+};
+
+// Comparação em três vias das árvores de busca usando o PrefixoChave guardado em cada nó.
+// - Prefixos diferentes: a ordem sai de uma única comparação de inteiros (big-endian preserva
+//   a ordem lexicográfica de bytes sem sinal, a mesma de std::string).
+// - Prefixos iguais e alguma chave com até 8 bytes: ela é prefixo da outra, decide o tamanho.
+// - Prefixos iguais e as duas com mais de 8 bytes: caminho lento, compara o restante das chaves.
+// Só vale para chaves com data()/size() de char ordenadas por std::less (std::string, ChaveCurta).
+// Para as demais chaves 'ativo' é falso: todo passo vai para o caminho lento, que usa 'Compare'.
+template <typename Chave, typename Compare = std::less<Chave>, typename = void>
+struct ComparadorPrefixo {
+    static constexpr bool ativo = false;
+
+    static PrefixoChave prefixo(const Chave&) { return PrefixoChave(); }
+    static bool decide(const PrefixoChave&, const PrefixoChave&, int&) { return false; }
+
+    int comparar(const Chave& a, const Chave& b) const {
+        if (compare(a, b)) return -1;
+        return compare(b, a) ? 1 : 0;
+    }
+
+private:
+    Compare compare;
+};
+
+template <typename Chave>
+struct ComparadorPrefixo<Chave, std::less<Chave>,
+                         std::enable_if_t<std::is_same<decltype(std::declval<const Chave&>().data()), const char*>::value &&
+                                          std::is_convertible<decltype(std::declval<const Chave&>().size()), size_t>::value>> {
+    static constexpr bool ativo = true;
+
+    static PrefixoChave prefixo(const Chave& chave) {
+        PrefixoChave p;
+        size_t tamanho = chave.size();
+        uint64_t bits = 0;
+        std::memcpy(&bits, chave.data(), std::min<size_t>(tamanho, 8));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        bits = __builtin_bswap64(bits);
+#endif
+        p.bits = bits;
+        p.tamanho = static_cast<uint32_t>(std::min<size_t>(tamanho, std::numeric_limits<uint32_t>::max()));
+        return p;
+    }
+
+    // Retorna true se os prefixos bastam; 'resultado' recebe < 0, 0 ou > 0.
+    static bool decide(const PrefixoChave& a, const PrefixoChave& b, int& resultado) {
+        if (a.bits != b.bits) {
+            resultado = a.bits < b.bits ? -1 : 1;
+            return true;
+        }
+        if (a.tamanho <= 8 || b.tamanho <= 8) {
+            resultado = (a.tamanho > b.tamanho) - (a.tamanho < b.tamanho);
+            return true;
+        }
+        return false;
+    }
+
+    // Caminho lento: só é chamado com prefixos iguais e as duas chaves com mais de 8 bytes.
+    int comparar(const Chave& a, const Chave& b) const {
+        size_t ta = a.size(), tb = b.size();
+        int c = std::memcmp(a.data() + 8, b.data() + 8, std::min(ta, tb) - 8);
+        if (c != 0) return c;
+        return (ta > tb) - (ta < tb);
+    }
+};
+
+#endif // PREFIXO_CHAVE_HPP
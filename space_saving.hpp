@@ -0,0 +1,168 @@
+#ifndef SPACE_SAVING_HPP
+#define SPACE_SAVING_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <vector>
+#include "ChainedHashTable.hpp" // Índice chave -> contador
+
+// Algoritmo Space-Saving (Metwally et al.) para os K elementos mais frequentes de um fluxo.
+// Usa exatamente K contadores (memória O(K)). Para um fluxo de N ocorrências:
+// - a contagem reportada c de um elemento satisfaz c - erro <= frequência real <= c;
+// - o erro de qualquer contador é no máximo N / K;
+// - todo elemento com frequência real > N / K está entre os monitorados.
+// Os contadores ficam no "stream-summary": uma lista duplamente encadeada de baldes em ordem
+// crescente de contagem, cada balde com a lista dos contadores que têm aquele valor.
+// Incrementar move o contador para o balde vizinho, então cada atualização custa O(1).
+template <typename Key, typename Hash = std::hash<Key>>
+class SpaceSaving {
+private:
+    struct Balde;
+
+    struct Contador {
+        Key chave;
+        uint64_t erro = 0;       // Contagem herdada do elemento despejado (superestimação máxima)
+        Balde* balde = nullptr;
+        Contador* ant = nullptr; // Vizinhos dentro do balde
+        Contador* prox = nullptr;
+    };
+
+    struct Balde {
+        uint64_t valor = 0;        // Contagem compartilhada pelos contadores do balde
+        Contador* primeiro = nullptr;
+        Balde* ant = nullptr;      // Balde de contagem menor
+        Balde* prox = nullptr;     // Balde de contagem maior
+    };
+
+    size_t m_capacidade;
+    std::vector<Contador> m_contadores; // Pré-alocados: ponteiros estáveis
+    size_t m_usados = 0;
+    std::vector<Balde> m_baldes;        // Há no máximo K baldes em uso ao mesmo tempo
+    std::vector<Balde*> m_baldes_livres;
+    Balde* m_menor = nullptr;           // Balde de menor contagem (início da lista)
+    ChainedHashTable<Key, Contador*, Hash, OrdemInsercao, NullStats> m_indice; // Comparações não são reportadas
+    uint64_t m_total = 0;
+
+    Balde* novoBalde(uint64_t valor) {
+        Balde* b = m_baldes_livres.back();
+        m_baldes_livres.pop_back();
+        *b = Balde();
+        b->valor = valor;
+        return b;
+    }
+
+    void liberarBalde(Balde* b) {
+        if (b->ant) b->ant->prox = b->prox;
+        else m_menor = b->prox;
+        if (b->prox) b->prox->ant = b->ant;
+        m_baldes_livres.push_back(b);
+    }
+
+    // Remove o contador da lista do seu balde (sem liberar o balde).
+    static void desligar(Contador* c) {
+        if (c->ant) c->ant->prox = c->prox;
+        else c->balde->primeiro = c->prox;
+        if (c->prox) c->prox->ant = c->ant;
+        c->ant = c->prox = nullptr;
+    }
+
+    static void ligar(Contador* c, Balde* b) {
+        c->balde = b;
+        c->ant = nullptr;
+        c->prox = b->primeiro;
+        if (b->primeiro) b->primeiro->ant = c;
+        b->primeiro = c;
+    }
+
+    // Passa o contador para o balde de valor + 1, criando-o se necessário.
+    void incrementar(Contador* c) {
+        Balde* atual = c->balde;
+        uint64_t novo_valor = atual->valor + 1;
+        Balde* seguinte = atual->prox;
+
+        if (seguinte && seguinte->valor == novo_valor) {
+            desligar(c);
+            ligar(c, seguinte);
+        } else if (atual->primeiro == c && c->prox == nullptr) {
+            // Único contador do balde: basta aumentar o valor (a ordem continua válida).
+            atual->valor = novo_valor;
+            return;
+        } else {
+            Balde* b = novoBalde(novo_valor);
+            b->ant = atual;
+            b->prox = seguinte;
+            atual->prox = b;
+            if (seguinte) seguinte->ant = b;
+            desligar(c);
+            ligar(c, b);
+        }
+        if (!atual->primeiro) liberarBalde(atual);
+    }
+
+public:
+    // Cria o resumo com 'k' contadores.
+    explicit SpaceSaving(size_t k)
+        : m_capacidade(std::max<size_t>(k, 1)), m_contadores(m_capacidade), m_baldes(m_capacidade + 1),
+          m_indice(m_capacidade + 1) {
+        m_baldes_livres.reserve(m_baldes.size());
+        for (auto& b : m_baldes) m_baldes_livres.push_back(&b);
+    }
+
+    SpaceSaving(const SpaceSaving&) = delete;
+    SpaceSaving& operator=(const SpaceSaving&) = delete;
+
+    // Conta uma ocorrência de 'key'.
+    void add(const Key& key) {
+        m_total++;
+        Contador* c = m_indice.count(key); // nullptr se não monitorado
+        if (c) {
+            incrementar(c);
+            return;
+        }
+
+        if (m_usados < m_capacidade) {
+            // Ainda há contador livre: entra com contagem 1.
+            c = &m_contadores[m_usados++];
+            c->chave = key;
+            c->erro = 0;
+            if (!m_menor || m_menor->valor != 1) {
+                Balde* b = novoBalde(1);
+                b->prox = m_menor;
+                if (m_menor) m_menor->ant = b;
+                m_menor = b;
+            }
+            ligar(c, m_menor);
+        } else {
+            // Substitui um elemento de contagem mínima; o novo herda essa contagem como erro.
+            c = m_menor->primeiro;
+            m_indice.remove(c->chave);
+            c->chave = key;
+            c->erro = m_menor->valor;
+            incrementar(c);
+        }
+        m_indice.add(key, c);
+    }
+
+    // Retorna (chave, contagem, erro) de todos os monitorados, em ordem decrescente de contagem.
+    std::vector<std::tuple<Key, uint64_t, uint64_t>> topK() const {
+        std::vector<std::tuple<Key, uint64_t, uint64_t>> result;
+        result.reserve(m_usados);
+        for (const Balde* b = m_menor; b; b = b->prox)
+            for (const Contador* c = b->primeiro; c; c = c->prox)
+                result.emplace_back(c->chave, b->valor, c->erro);
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+    size_t capacidade() const { return m_capacidade; }
+    size_t monitorados() const { return m_usados; }
+    uint64_t total() const { return m_total; }
+    // Limite superior do erro de qualquer contagem: N / K.
+    uint64_t erroMaximo() const { return m_total / m_capacidade; }
+    // Menor contagem monitorada (0 se ainda há contadores livres).
+    uint64_t minimo() const { return (m_usados < m_capacidade || !m_menor) ? 0 : m_menor->valor; }
+};
+
+#endif // SPACE_SAVING_HPP
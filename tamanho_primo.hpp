@@ -0,0 +1,94 @@
+#ifndef TAMANHO_PRIMO_HPP
+#define TAMANHO_PRIMO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// Política de tamanho das tabelas hash com número primo de buckets (ChainedHashTable e HashAberto).
+// - Os tamanhos vêm de uma escada de primos pré-calculada (o menor primo >= 2^(k/2), k = 3, 4, ...),
+//   então redimensionar não faz divisão por tentativa e a reserva desperdiça no máximo ~41%.
+// - A redução h % primo usa o "fastmod" de Lemire: com M = floor((2^128 - 1) / primo) + 1
+//   calculado uma vez por tamanho, h % primo = ((M * h) mod 2^128) * primo / 2^128, só com
+//   multiplicações. O resultado é exatamente o resto, então a distribuição é a mesma do '%'.
+// Sem inteiros de 128 bits no compilador, cai no '%' comum.
+class TamanhoPrimo {
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 u128;
+#endif
+
+public:
+    explicit TamanhoPrimo(size_t minimo = 19) { ajustar(minimo); }
+
+    // Menor primo da escada >= n.
+    static size_t proximo(size_t n) {
+        for (uint64_t p : ESCADA)
+            if (p >= n) return static_cast<size_t>(p);
+        throw std::length_error("Tamanho de tabela acima da escada de primos");
+    }
+
+    // Primo da escada dois degraus acima de proximo(n): o crescimento das tabelas (~2x).
+    // Dobrar o primo e arredondar com proximo() às vezes pula um degrau (521 -> 1451), e o
+    // crescimento alterna entre ~2x e ~2.8x; avançando pelo índice ele fica sempre em ~2x.
+    static size_t crescer(size_t n) {
+        constexpr size_t degraus = sizeof(ESCADA) / sizeof(ESCADA[0]);
+        for (size_t i = 0; i + 2 < degraus; ++i)
+            if (ESCADA[i] >= n) return static_cast<size_t>(ESCADA[i + 2]);
+        throw std::length_error("Tamanho de tabela acima da escada de primos");
+    }
+
+    // Passa a usar o menor primo da escada >= n.
+    void ajustar(size_t n) {
+        m_primo = proximo(n);
+#ifdef __SIZEOF_INT128__
+        m_multiplicador = ~static_cast<u128>(0) / m_primo + 1;
+#endif
+    }
+
+    size_t tamanho() const { return m_primo; }
+
+    // h % tamanho()
+    size_t reduzir(uint64_t h) const {
+#ifdef __SIZEOF_INT128__
+        u128 baixo = m_multiplicador * h;
+        // (baixo * primo) >> 128, em duas metades de 64 bits para não transbordar.
+        u128 metade_baixa = (static_cast<u128>(static_cast<uint64_t>(baixo)) * m_primo) >> 64;
+        u128 metade_alta = static_cast<u128>(static_cast<uint64_t>(baixo >> 64)) * m_primo;
+        return static_cast<size_t>((metade_baixa + metade_alta) >> 64);
+#else
+        return static_cast<size_t>(h % m_primo);
+#endif
+    }
+
+private:
+    static constexpr uint64_t ESCADA[] = {
+        3ULL, 5ULL, 7ULL, 11ULL, 13ULL, 17ULL,
+        23ULL, 37ULL, 47ULL, 67ULL, 97ULL, 131ULL,
+        191ULL, 257ULL, 367ULL, 521ULL, 727ULL, 1031ULL,
+        1451ULL, 2053ULL, 2897ULL, 4099ULL, 5801ULL, 8209ULL,
+        11587ULL, 16411ULL, 23173ULL, 32771ULL, 46349ULL, 65537ULL,
+        92683ULL, 131101ULL, 185369ULL, 262147ULL, 370759ULL, 524309ULL,
+        741457ULL, 1048583ULL, 1482919ULL, 2097169ULL, 2965847ULL, 4194319ULL,
+        5931649ULL, 8388617ULL, 11863289ULL, 16777259ULL, 23726569ULL, 33554467ULL,
+        47453149ULL, 67108879ULL, 94906297ULL, 134217757ULL, 189812533ULL, 268435459ULL,
+        379625083ULL, 536870923ULL, 759250133ULL, 1073741827ULL, 1518500279ULL, 2147483659ULL,
+        3037000507ULL, 4294967311ULL, 6074001001ULL, 8589934609ULL, 12148002047ULL, 17179869209ULL,
+        24296004011ULL, 34359738421ULL, 48592008053ULL, 68719476767ULL, 97184016049ULL, 137438953481ULL,
+        194368032011ULL, 274877906951ULL, 388736063999ULL, 549755813911ULL, 777472128049ULL, 1099511627791ULL,
+        1554944255989ULL, 2199023255579ULL, 3109888512037ULL, 4398046511119ULL, 6219777023959ULL, 8796093022237ULL,
+        12439554047911ULL, 17592186044423ULL, 24879108095833ULL, 35184372088891ULL, 49758216191633ULL, 70368744177679ULL,
+        99516432383281ULL, 140737488355333ULL, 199032864766447ULL, 281474976710677ULL, 398065729532981ULL, 562949953421381ULL,
+        796131459065743ULL, 1125899906842679ULL, 1592262918131449ULL, 2251799813685269ULL, 3184525836262943ULL, 4503599627370517ULL,
+        6369051672525833ULL, 9007199254740997ULL, 12738103345051607ULL, 18014398509482143ULL, 25476206690103097ULL, 36028797018963971ULL,
+        50952413380206277ULL, 72057594037928017ULL, 101904826760412407ULL, 144115188075855881ULL, 203809653520824899ULL, 288230376151711813ULL,
+        407619307041649517ULL, 576460752303423619ULL, 815238614083298983ULL, 1152921504606847009ULL, 1630477228166598073ULL, 2305843009213693967ULL,
+        3260954456333195779ULL, 4611686018427388039ULL, 6521908912666391591ULL
+    };
+
+    size_t m_primo = 0;
+#ifdef __SIZEOF_INT128__
+    u128 m_multiplicador = 0;
+#endif
+};
+
+#endif // TAMANHO_PRIMO_HPP